@@ -31,12 +31,17 @@ LOCAL_SRC_FILES += Dun.cpp
 LOCAL_SRC_FILES += Dun.h
 LOCAL_SRC_FILES += Event.cpp
 LOCAL_SRC_FILES += Event.h
+LOCAL_SRC_FILES += EventManager.cpp
 LOCAL_SRC_FILES += EventManager.h
 LOCAL_SRC_FILES += FadeInOut.cpp
 LOCAL_SRC_FILES += FadeInOut.h
+LOCAL_SRC_FILES += FileTemplateCache.cpp
+LOCAL_SRC_FILES += FileTemplateCache.h
 LOCAL_SRC_FILES += FileUtils.cpp
 LOCAL_SRC_FILES += FileUtils.h
 LOCAL_SRC_FILES += Font2.h
+LOCAL_SRC_FILES += FrameTimeHistogram.cpp
+LOCAL_SRC_FILES += FrameTimeHistogram.h
 LOCAL_SRC_FILES += Game.cpp
 LOCAL_SRC_FILES += Game.h
 LOCAL_SRC_FILES += GameUtils.cpp
@@ -47,6 +52,8 @@ LOCAL_SRC_FILES += Image.cpp
 LOCAL_SRC_FILES += Image.h
 LOCAL_SRC_FILES += ImageUtils.cpp
 LOCAL_SRC_FILES += ImageUtils.h
+LOCAL_SRC_FILES += InputRecorder.cpp
+LOCAL_SRC_FILES += InputRecorder.h
 LOCAL_SRC_FILES += InputText.cpp
 LOCAL_SRC_FILES += InputText.h
 LOCAL_SRC_FILES += LoadingScreen.cpp
@@ -62,10 +69,18 @@ LOCAL_SRC_FILES += MovieStub.h
 LOCAL_SRC_FILES += Music2.h
 LOCAL_SRC_FILES += Palette.cpp
 LOCAL_SRC_FILES += Palette.h
+LOCAL_SRC_FILES += ParseTracer.cpp
+LOCAL_SRC_FILES += ParseTracer.h
 LOCAL_SRC_FILES += Pcx.cpp
 LOCAL_SRC_FILES += Pcx.h
 LOCAL_SRC_FILES += PhysFSStream.cpp
 LOCAL_SRC_FILES += PhysFSStream.h
+LOCAL_SRC_FILES += Profiler.cpp
+LOCAL_SRC_FILES += Profiler.h
+LOCAL_SRC_FILES += PropertyPath.cpp
+LOCAL_SRC_FILES += PropertyPath.h
+LOCAL_SRC_FILES += PropertyQuery.cpp
+LOCAL_SRC_FILES += PropertyQuery.h
 LOCAL_SRC_FILES += Queryable.h
 LOCAL_SRC_FILES += Rectangle.cpp
 LOCAL_SRC_FILES += Rectangle.h
@@ -84,6 +99,10 @@ LOCAL_SRC_FILES += StringText.cpp
 LOCAL_SRC_FILES += StringText.h
 LOCAL_SRC_FILES += Text2.cpp
 LOCAL_SRC_FILES += Text2.h
+LOCAL_SRC_FILES += TextBindings.cpp
+LOCAL_SRC_FILES += TextBindings.h
+LOCAL_SRC_FILES += TextTemplate.cpp
+LOCAL_SRC_FILES += TextTemplate.h
 LOCAL_SRC_FILES += TextUtils.cpp
 LOCAL_SRC_FILES += TextUtils.h
 LOCAL_SRC_FILES += TileSet.cpp
@@ -94,6 +113,8 @@ LOCAL_SRC_FILES += Utils.h
 LOCAL_SRC_FILES += UIText.h
 LOCAL_SRC_FILES += Variable.cpp
 LOCAL_SRC_FILES += Variable.h
+LOCAL_SRC_FILES += VariableStore.cpp
+LOCAL_SRC_FILES += VariableStore.h
 LOCAL_SRC_FILES += Variant.h
 LOCAL_SRC_FILES += VarOrPredicate.h
 LOCAL_SRC_FILES += View2.cpp
@@ -131,13 +152,23 @@ LOCAL_SRC_FILES += Actions/ActVariable.h
 LOCAL_SRC_FILES += Actions/ActVisibility.h
 LOCAL_SRC_FILES += Game/CelLevelObject.cpp
 LOCAL_SRC_FILES += Game/CelLevelObject.h
+LOCAL_SRC_FILES += Game/ConnectedRegions.cpp
+LOCAL_SRC_FILES += Game/ConnectedRegions.h
+LOCAL_SRC_FILES += Game/FlowField.cpp
+LOCAL_SRC_FILES += Game/FlowField.h
 LOCAL_SRC_FILES += Game/Formula.cpp
 LOCAL_SRC_FILES += Game/Formula.h
-LOCAL_SRC_FILES += Game/fsa.h
 LOCAL_SRC_FILES += Game/GameProperties.cpp
 LOCAL_SRC_FILES += Game/GameProperties.h
+LOCAL_SRC_FILES += Game/GridPathFinder.cpp
+LOCAL_SRC_FILES += Game/GridPathFinder.h
+LOCAL_SRC_FILES += Game/HierarchicalPathFinder.cpp
+LOCAL_SRC_FILES += Game/HierarchicalPathFinder.h
 LOCAL_SRC_FILES += Game/ImageLevelObject.cpp
 LOCAL_SRC_FILES += Game/ImageLevelObject.h
+LOCAL_SRC_FILES += Game/IncrementalPathFinder.cpp
+LOCAL_SRC_FILES += Game/IncrementalPathFinder.h
+LOCAL_SRC_FILES += Game/IndexedHeap.h
 LOCAL_SRC_FILES += Game/Item.cpp
 LOCAL_SRC_FILES += Game/Item.h
 LOCAL_SRC_FILES += Game/ItemClass.cpp
@@ -160,20 +191,31 @@ LOCAL_SRC_FILES += Game/LevelObject.h
 LOCAL_SRC_FILES += Game/MapCoord.h
 LOCAL_SRC_FILES += Game/Namer.cpp
 LOCAL_SRC_FILES += Game/Namer.h
+LOCAL_SRC_FILES += Game/NearestCellFinder.cpp
+LOCAL_SRC_FILES += Game/NearestCellFinder.h
 LOCAL_SRC_FILES += Game/Number.h
 LOCAL_SRC_FILES += Game/PairXY.h
-LOCAL_SRC_FILES += Game/PathFinder.cpp
-LOCAL_SRC_FILES += Game/PathFinder.h
+LOCAL_SRC_FILES += Game/PathFinderBenchmark.cpp
+LOCAL_SRC_FILES += Game/PathFinderBenchmark.h
+LOCAL_SRC_FILES += Game/PathJobQueue.cpp
+LOCAL_SRC_FILES += Game/PathJobQueue.h
 LOCAL_SRC_FILES += Game/Player.cpp
 LOCAL_SRC_FILES += Game/Player.h
 LOCAL_SRC_FILES += Game/PlayerClass.cpp
 LOCAL_SRC_FILES += Game/PlayerClass.h
 LOCAL_SRC_FILES += Game/Quest.cpp
 LOCAL_SRC_FILES += Game/Quest.h
-LOCAL_SRC_FILES += Game/stlastar.h
+LOCAL_SRC_FILES += Json/JsonBinary.cpp
+LOCAL_SRC_FILES += Json/JsonBinary.h
+LOCAL_SRC_FILES += Json/JsonCache.cpp
+LOCAL_SRC_FILES += Json/JsonCache.h
 LOCAL_SRC_FILES += Json/JsonParser.h
 LOCAL_SRC_FILES += Json/JsonUtils.cpp
 LOCAL_SRC_FILES += Json/JsonUtils.h
+LOCAL_SRC_FILES += Json/PooledDocument.cpp
+LOCAL_SRC_FILES += Json/PooledDocument.h
+LOCAL_SRC_FILES += Parser/ParallelLoader.cpp
+LOCAL_SRC_FILES += Parser/ParallelLoader.h
 LOCAL_SRC_FILES += Parser/ParseAction.cpp
 LOCAL_SRC_FILES += Parser/ParseAction.h
 LOCAL_SRC_FILES += Parser/ParseAnimation.cpp
@@ -267,6 +309,8 @@ LOCAL_SRC_FILES += Predicates/Predicate.h
 LOCAL_SRC_FILES += Predicates/PredIO.h
 LOCAL_SRC_FILES += Predicates/PredItem.h
 LOCAL_SRC_FILES += Predicates/PredPlayer.h
+LOCAL_SRC_FILES += Predicates/PredProperty.h
+LOCAL_SRC_FILES += Predicates/PredVariable.h
 LOCAL_SRC_FILES += rapidjson/allocators.h
 LOCAL_SRC_FILES += rapidjson/document.h
 LOCAL_SRC_FILES += rapidjson/encodedstream.h
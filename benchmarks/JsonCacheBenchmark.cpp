@@ -0,0 +1,97 @@
+// Times, for each json file given, what Parser::parseFile does end to end
+// (reading the file through PhysFS included):
+// - parse: the cache is off, so the text is read and parsed.
+// - text: the text is read, hashed and its binary form loaded from the
+//   cache (files loaded with parameters and saved games).
+// - file: the binary form is found by path, size and time and loaded,
+//   without reading the text (game files).
+//
+// build: cmake -DDGENGINE_BENCHMARKS=TRUE, then run from the game dir
+//   JsonCacheBenchmark level/item/prefixes.json ...
+
+#include <chrono>
+#include "FileUtils.h"
+#include <iostream>
+#include "Json/JsonCache.h"
+#include "Json/PooledDocument.h"
+#include "PhysFSStream.h"
+#include <string>
+
+static const int iterations = 200;
+
+template <class Func>
+static double measure(Func func)
+{
+	auto start = std::chrono::high_resolution_clock::now();
+	for (int i = 0; i < iterations; i++)
+	{
+		func();
+	}
+	auto end = std::chrono::high_resolution_clock::now();
+	return std::chrono::duration<double, std::micro>(end - start).count() / iterations;
+}
+
+int main(int argc, char *argv[])
+{
+	PHYSFS_init(NULL);
+	PHYSFS_mount(".", NULL, 0);
+
+	JsonCache noCache;
+	noCache.Enabled(false);
+	JsonCache cache;
+	cache.MaxSize(256 * 1024 * 1024);
+
+	double totalParse = 0.0;
+	double totalText = 0.0;
+	double totalFile = 0.0;
+	for (int i = 1; i < argc; i++)
+	{
+		std::string fileName(argv[i]);
+		bool valid;
+		{
+			PooledDocument json;
+			valid = noCache.parseFile(fileName, json.Text(), json.Doc());
+		}
+		if (valid == false)
+		{
+			std::cout << fileName << ": invalid json\n";
+			continue;
+		}
+		{
+			// fills the cache with both keys
+			PooledDocument json;
+			cache.parseFile(fileName, json.Text(), json.Doc());
+			PooledDocument json2;
+			FileUtils::readText(fileName.c_str(), json2.Text());
+			cache.parse(fileName, json2.Text(), json2.Doc(), false);
+		}
+
+		auto parseTime = measure([&]()
+		{
+			PooledDocument json;
+			noCache.parseFile(fileName, json.Text(), json.Doc());
+		});
+		auto textTime = measure([&]()
+		{
+			PooledDocument json;
+			FileUtils::readText(fileName.c_str(), json.Text());
+			cache.parse(fileName, json.Text(), json.Doc(), false);
+		});
+		auto fileTime = measure([&]()
+		{
+			PooledDocument json;
+			cache.parseFile(fileName, json.Text(), json.Doc());
+		});
+		totalParse += parseTime;
+		totalText += textTime;
+		totalFile += fileTime;
+
+		std::cout << fileName << ": parse " << parseTime << " us, text "
+			<< textTime << " us, file " << fileTime << " us\n";
+	}
+	std::cout << "total: parse " << totalParse << " us, text "
+		<< totalText << " us, file " << totalFile << " us\n";
+
+	PHYSFS_deinit();
+	return 0;
+}
@@ -0,0 +1,128 @@
+// Compares the %placeholder% replacement done with std::regex (the code
+// used before TextTemplate) with TextTemplate, scanning every time (like
+// the json replaceVars) and scanning once (like the text actions).
+//
+// build: cmake -DDGENGINE_BENCHMARKS=TRUE, then run TextTemplateBenchmark
+
+#include <chrono>
+#include <iostream>
+#include <map>
+#include <regex>
+#include <string>
+#include "TextTemplate.h"
+#include "Utils.h"
+#include "Variable.h"
+#include <vector>
+
+static std::map<std::string, Variable> properties =
+{
+	{ "name", Variable(std::string("Short Sword")) },
+	{ "damageMin", Variable((int64_t)2) },
+	{ "damageMax", Variable((int64_t)6) },
+	{ "durability", Variable((int64_t)24) },
+	{ "durabilityMax", Variable((int64_t)32) },
+	{ "currentLevel.name", Variable(std::string("Town")) },
+	{ "prices.sell", Variable((int64_t)1250) },
+};
+
+static bool getProperty(const std::string& prop, Variable& var)
+{
+	auto it = properties.find(prop);
+	if (it != properties.end())
+	{
+		var = it->second;
+		return true;
+	}
+	return false;
+}
+
+static std::regex regexPercent(R"((\%[\w.]+\%))");
+
+static std::string replaceWithRegex(const std::string& str)
+{
+	std::string str1(str);
+	std::string str2(str1);
+	std::smatch match;
+	while (std::regex_search(str1, match, regexPercent) == true)
+	{
+		auto strProp = match[1].str();
+		Variable var;
+		if (getProperty(strProp.substr(1, strProp.size() - 2), var) == true)
+		{
+			Utils::replaceStringInPlace(
+				str2, strProp, VarUtils::toString(var));
+		}
+		str1 = match.suffix().str();
+	}
+	return str2;
+}
+
+static std::string replaceWithTemplate(const TextTemplate& strTemplate)
+{
+	std::string str;
+	strTemplate.render(str, getProperty);
+	return str;
+}
+
+template <class Func>
+static double measure(size_t iterations, Func func)
+{
+	auto start = std::chrono::steady_clock::now();
+	for (size_t i = 0; i < iterations; i++)
+	{
+		func();
+	}
+	auto end = std::chrono::steady_clock::now();
+	return std::chrono::duration<double, std::micro>(end - start).count() / (double)iterations;
+}
+
+int main(int argc, char *argv[])
+{
+	size_t iterations = 100000;
+	if (argc > 1)
+	{
+		iterations = std::strtoul(argv[1], nullptr, 10);
+	}
+
+	std::vector<std::string> strings =
+	{
+		"No placeholders in this text",
+		"%name%",
+		"Damage: %damageMin%-%damageMax%",
+		"Durability: %durability%/%durabilityMax%  Sell: %prices.sell% gold",
+		"Level %currentLevel.name% %unknown% 100% %name% %name%",
+	};
+
+	std::cout << "iterations: " << iterations << "\n";
+	size_t mismatches = 0;
+	for (const auto& str : strings)
+	{
+		TextTemplate strTemplate(str);
+		if (replaceWithRegex(str) != replaceWithTemplate(strTemplate))
+		{
+			std::cout << "mismatch: " << str << "\n";
+			mismatches++;
+		}
+
+		size_t sink = 0;
+		auto regexTime = measure(iterations, [&]()
+		{
+			sink += replaceWithRegex(str).size();
+		});
+		auto scanTime = measure(iterations, [&]()
+		{
+			sink += replaceWithTemplate(TextTemplate(str)).size();
+		});
+		auto renderTime = measure(iterations, [&]()
+		{
+			sink += replaceWithTemplate(strTemplate).size();
+		});
+
+		std::cout << "\"" << str << "\"\n";
+		std::cout << "  regex (us): " << regexTime
+			<< "  scan+render (us): " << scanTime
+			<< "  render (us): " << renderTime
+			<< "  (" << sink << ")\n";
+	}
+	return mismatches == 0 ? 0 : 1;
+}
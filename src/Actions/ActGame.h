@@ -18,7 +18,7 @@ class ActGameClose : public Action
 public:
 	virtual bool execute(Game& game)
 	{
-		game.Window().close();
+		game.close();
 		return true;
 	}
 };
@@ -53,6 +53,24 @@ public:
 	}
 };
 
+class ActGameSaveProfile : public Action
+{
+private:
+	std::string file;
+
+public:
+	ActGameSaveProfile(const std::string& file_) : file(file_) {}
+
+	virtual bool execute(Game& game)
+	{
+		if (file.empty() == false)
+		{
+			game.getProfiler().saveTrace(file);
+		}
+		return true;
+	}
+};
+
 class ActGameSetMusicVolume : public Action
 {
 private:
@@ -37,8 +37,8 @@ public:
 		if (filesRead.size() > 0)
 		{
 			const auto& fileRead = filesRead[0];
-			auto str = FileUtils::readText(game.getVarOrPropString(fileRead).c_str());
 
+			std::vector<std::string> params;
 			std::string param;
 			Variable var2;
 
@@ -76,9 +76,12 @@ public:
 				{
 					param = varStr;
 				}
-				Utils::replaceStringInPlace(str, "{" + std::to_string(i) + "}", param);
+				params.push_back(param);
 			}
 
+			std::string str;
+			game.getFileTemplates().expand(game.getVarOrPropString(fileRead), params, str);
+
 			auto writePath = game.getVarOrPropString(dir);
 			if (writePath.size() > 0 && Utils::endsWith(writePath, "/") == false)
 			{
@@ -1,8 +1,44 @@
 #pragma once
 
 #include "Action.h"
+#include "FileUtils.h"
 #include "Game.h"
 #include "Game/Level.h"
+#include "Game/PathFinderBenchmark.h"
+#include <iostream>
+
+class ActLevelBenchmarkPathFinder : public Action
+{
+private:
+	std::string id;
+	std::string file;
+	size_t searches;
+	uint32_t seed;
+
+public:
+	ActLevelBenchmarkPathFinder(const std::string& id_, const std::string& file_,
+		size_t searches_, uint32_t seed_)
+		: id(id_), file(file_), searches(searches_), seed(seed_) {}
+
+	virtual bool execute(Game& game)
+	{
+		auto level = game.Resources().getLevel(id);
+		if (level != nullptr)
+		{
+			auto results = PathFinderBenchmark::run(level->Map(), searches, seed);
+			auto str = PathFinderBenchmark::toString(results);
+			if (file.empty() == false)
+			{
+				FileUtils::saveText(game.getVarOrPropString(file).c_str(), str);
+			}
+			else
+			{
+				std::cout << str;
+			}
+		}
+		return true;
+	}
+};
 
 class ActLevelClearObjects : public Action
 {
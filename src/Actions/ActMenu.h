@@ -13,8 +13,8 @@ class ActMenuAppendText : public Action
 private:
 	std::string id;
 	size_t idx;
-	std::string textFormat;
-	std::vector<std::string> bindings;
+	TextTemplate textFormat;
+	TextBindings bindings;
 	TextUtils::TextOp textOp;
 
 public:
@@ -27,7 +27,7 @@ public:
 		: id(id_), idx(idx_), textFormat(text_),
 		textOp(TextUtils::TextOp::Query)
 	{
-		bindings.push_back(query_);
+		bindings.set({ query_ });
 	}
 
 	ActMenuAppendText(const std::string& id_,
@@ -259,8 +259,8 @@ class ActMenuSetText : public Action
 private:
 	std::string id;
 	size_t idx;
-	std::string textFormat;
-	std::vector<std::string> bindings;
+	TextTemplate textFormat;
+	TextBindings bindings;
 	TextUtils::TextOp textOp;
 
 public:
@@ -273,7 +273,7 @@ public:
 		: id(id_), idx(idx_), textFormat(text_),
 		textOp(TextUtils::TextOp::Query)
 	{
-		bindings.push_back(query_);
+		bindings.set({ query_ });
 	}
 
 	ActMenuSetText(const std::string& id_,
@@ -163,18 +163,26 @@ public:
 			auto player = level->getPlayerOrCurrent(idPlayer);
 			if (player != nullptr)
 			{
-				MapCoord a = player->MapPosition();
 				MapCoord b;
+				std::shared_ptr<LevelObject> target;
 				auto hoverObj = level->getHoverObject();
 				if (hoverObj != nullptr && hoverObj != player)
 				{
 					b = hoverObj->MapPosition();
+					target = level->Map()[b].getObject(hoverObj);
 				}
 				else
 				{
 					b = level->getMapCoordOverMouse();
 				}
-				player->setWalkPath(level->Map().getPath(a, b));
+				if (player->getWalkMode() != PlayerWalkMode::Path)
+				{
+					player->setWalkGoal(b, target);
+				}
+				else
+				{
+					level->setWalkPath(*player, b);
+				}
 			}
 		}
 		return true;
@@ -4,13 +4,16 @@
 #include "Game.h"
 #include "Parser/Parser.h"
 #include <string>
+#include <vector>
 
 class ActResourceAdd : public Action
 {
 private:
 	std::string id;
 	IgnoreResource ignorePrevious;
+	sf::FloatRect opaqueRect;
 	bool hasIgnore{ false };
+	bool opaque{ false };
 
 public:
 	ActResourceAdd(const std::string& id_) : id(id_) {}
@@ -21,6 +24,12 @@ public:
 		hasIgnore = true;
 	}
 
+	void setOpaque(const sf::FloatRect& rect)
+	{
+		opaqueRect = rect;
+		opaque = true;
+	}
+
 	virtual bool execute(Game& game)
 	{
 		if (hasIgnore == true)
@@ -28,6 +37,20 @@ public:
 			game.Resources().ignoreTopResource(ignorePrevious);
 		}
 		game.Resources().addResource(id);
+		if (opaque == true)
+		{
+			game.Resources().setTopResourceOpaque(opaqueRect);
+		}
+		return true;
+	}
+};
+
+class ActResourceEvict : public Action
+{
+public:
+	virtual bool execute(Game& game)
+	{
+		game.Resources().evictLazyResources();
 		return true;
 	}
 };
@@ -99,3 +122,21 @@ public:
 		return true;
 	}
 };
+
+class ActResourcePrefetch : public Action
+{
+private:
+	std::vector<std::string> ids;
+
+public:
+	ActResourcePrefetch(const std::vector<std::string>& ids_) : ids(ids_) {}
+
+	virtual bool execute(Game& game)
+	{
+		for (const auto& id : ids)
+		{
+			game.Resources().prefetch(id);
+		}
+		return true;
+	}
+};
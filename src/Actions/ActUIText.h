@@ -9,8 +9,8 @@ class ActUITextAppendText : public Action
 {
 private:
 	std::string id;
-	std::string textFormat;
-	std::vector<std::string> bindings;
+	TextTemplate textFormat;
+	TextBindings bindings;
 	TextUtils::TextOp textOp;
 
 public:
@@ -21,7 +21,7 @@ public:
 		const std::string& query_) : id(id_), textFormat(text_),
 		textOp(TextUtils::TextOp::Query)
 	{
-		bindings.push_back(query_);
+		bindings.set({ query_ });
 	}
 
 	ActUITextAppendText(const std::string& id_, const std::string& format_,
@@ -90,8 +90,8 @@ class ActUITextSetText : public Action
 {
 private:
 	std::string id;
-	std::string textFormat;
-	std::vector<std::string> bindings;
+	TextTemplate textFormat;
+	TextBindings bindings;
 	TextUtils::TextOp textOp;
 
 public:
@@ -102,7 +102,7 @@ public:
 		const std::string& query_) : id(id_), textFormat(text_),
 		textOp(TextUtils::TextOp::Query)
 	{
-		bindings.push_back(query_);
+		bindings.set({ query_ });
 	}
 
 	ActUITextSetText(const std::string& id_, const std::string& format_,
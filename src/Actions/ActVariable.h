@@ -7,17 +7,14 @@
 class ActVariableClear : public Action
 {
 private:
-	std::string key;
+	uint32_t key;
 
 public:
-	ActVariableClear(const std::string& key_) : key(key_) {}
+	ActVariableClear(uint32_t key_) : key(key_) {}
 
 	virtual bool execute(Game& game)
 	{
-		if (key.size() > 0)
-		{
-			game.clearVariable(key);
-		}
+		game.clearVariable(key);
 		return true;
 	}
 };
@@ -45,19 +42,16 @@ public:
 class ActVariableSet : public Action
 {
 private:
-	std::string key;
+	uint32_t key;
 	Variable val;
 
 public:
-	ActVariableSet(const std::string& key_, const Variable& val_)
+	ActVariableSet(uint32_t key_, const Variable& val_)
 		: key(key_), val(val_) {}
 
 	virtual bool execute(Game& game)
 	{
-		if (key.size() > 0)
-		{
-			game.setVariable(key, val);
-		}
+		game.setVariable(key, val);
 		return true;
 	}
 };
@@ -66,25 +60,22 @@ class ActVariableSetId : public Action
 {
 private:
 	std::string id;
-	std::string key;
+	uint32_t key;
 	std::string property;
 
 public:
-	ActVariableSetId(const std::string& id_, const std::string& key_,
+	ActVariableSetId(const std::string& id_, uint32_t key_,
 		const std::string& property_) : id(id_), key(key_), property(property_) {}
 
 	virtual bool execute(Game& game)
 	{
-		if (key.size() > 0)
+		auto item = game.Resources().getResource<UIObject>(id);
+		if (item != nullptr)
 		{
-			auto item = game.Resources().getResource<UIObject>(id);
-			if (item != nullptr)
+			Variable var;
+			if (item->getProperty(property, var) == true)
 			{
-				Variable var;
-				if (item->getProperty(property, var) == true)
-				{
-					game.setVariable(key, var);
-				}
+				game.setVariable(key, var);
 			}
 		}
 		return true;
@@ -94,22 +85,19 @@ public:
 class ActVariableSetIfNull : public Action
 {
 private:
-	std::string key;
+	uint32_t key;
 	Variable val;
 
 public:
-	ActVariableSetIfNull(const std::string& key_, const Variable& val_)
+	ActVariableSetIfNull(uint32_t key_, const Variable& val_)
 		: key(key_), val(val_) {}
 
 	virtual bool execute(Game& game)
 	{
-		if (key.size() > 0)
+		Variable var;
+		if (game.getVariable(key, var) == false)
 		{
-			Variable var;
-			if (game.getVariableNoPercentage(key, var) == false)
-			{
-				game.setVariable(key, val);
-			}
+			game.setVariable(key, val);
 		}
 		return true;
 	}
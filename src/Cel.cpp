@@ -496,6 +496,16 @@ CelFile::CelFile(const char* filename, bool isCl2_, bool isTileCel_)
 	}
 }
 
+size_t CelFile::DataSize() const
+{
+	size_t size = 0;
+	for (const auto& frame : mFrames)
+	{
+		size += frame.size();
+	}
+	return size;
+}
+
 CelFrame CelFile::get(size_t index, const Palette& palette) const
 {
 	std::vector<sf::Color> rawImage;
@@ -65,6 +65,9 @@ public:
 
 	size_t Size() const { return mFrames.size(); }
 
+	// size of the frames' data in bytes
+	size_t DataSize() const;
+
 	///< if normal cel file, returns same as numFrames(), for an archive, the number of frames in each subcel
 	size_t AnimLength() const { return animLength; }
 };
@@ -31,6 +31,8 @@ public:
 	}
 
 	size_t size() const { return cel->Size(); }
+
+	const CelFile& getCelFile() const { return *cel; }
 };
 
 template <class T>
@@ -1,29 +1,13 @@
 #include "Event.h"
 #include "Game.h"
 
-bool Event::update(Game& game)
+bool Event::execute(Game& game) const
 {
 	if (action == nullptr)
 	{
 		return true;
 	}
-
-	currentTime += game.getElapsedTime();
-
-	if (currentTime >= timeout)
-	{
-		auto ret = action->execute(game);
-
-		if (ret == false && timeout != sf::Time::Zero)
-		{
-			// reset time, but keep the remainder
-			currentTime = sf::microseconds(currentTime.asMicroseconds() % timeout.asMicroseconds());
-		}
-		else
-		{
-			currentTime = sf::Time::Zero;
-		}
-		return ret;
-	}
-	return false;
+	// executing can add or remove events, which can move or delete this one
+	auto action_ = action;
+	return action_->execute(game);
 }
@@ -11,7 +11,6 @@ private:
 	std::string id;
 	std::shared_ptr<Action> action;
 	sf::Time timeout;
-	sf::Time currentTime;
 
 public:
 	explicit Event(const std::shared_ptr<Action>& action_,
@@ -21,9 +20,11 @@ public:
 	const std::string& getId() const { return id; }
 	void setId(const std::string& id_) { id = id_; }
 
+	const std::shared_ptr<Action>& getAction() const { return action; }
 	void setAction(const std::shared_ptr<Action>& action_) { action = action_; }
 
-	void resetTime() { currentTime = sf::Time::Zero; }
+	const sf::Time& getTimeout() const { return timeout; }
 
-	bool update(Game& game);
+	// executes the action. Returns true if the event is done.
+	bool execute(Game& game) const;
 };
@@ -0,0 +1,211 @@
+#include "EventManager.h"
+#include <algorithm>
+#include "Game.h"
+#include <limits>
+
+sf::Time EventManager::getStartTime(int64_t order) const
+{
+	// events done for this frame count their timeout from the next one
+	if (updating == true && order <= updateOrder)
+	{
+		return updateTime;
+	}
+	return currentTime;
+}
+
+void EventManager::add(const Event& event_, bool front)
+{
+	uint32_t idx;
+	if (freeEvents.empty() == false)
+	{
+		idx = freeEvents.back();
+		freeEvents.pop_back();
+	}
+	else
+	{
+		idx = (uint32_t)events.size();
+		events.push_back(ScheduledEvent());
+	}
+	auto& evt = events[idx];
+	evt.event = event_;
+	evt.order = (front == true ? --frontOrder : ++backOrder);
+	evt.startTime = getStartTime(evt.order);
+
+	if (event_.getId().empty() == false)
+	{
+		ids.insert(std::make_pair(event_.getId(), idx));
+	}
+
+	schedule(idx);
+}
+
+void EventManager::schedule(uint32_t idx)
+{
+	auto& evt = events[idx];
+	// older heap entries for this event are skipped
+	evt.version++;
+	if (updating == true && evt.order <= updateOrder)
+	{
+		// done for this frame (or added to the front while updating),
+		// so it only runs again from the next frame.
+		evt.state = State::Deferred;
+		deferredEvents.push_back(idx);
+		return;
+	}
+	evt.state = State::Queued;
+	auto deadline = evt.startTime + evt.event.getTimeout();
+	queue.push({ deadline.asMicroseconds(), evt.order, idx, evt.version });
+}
+
+void EventManager::release(uint32_t idx)
+{
+	auto& evt = events[idx];
+	const auto& id = evt.event.getId();
+	if (id.empty() == false)
+	{
+		auto range = ids.equal_range(id);
+		for (auto it = range.first; it != range.second; ++it)
+		{
+			if (it->second == idx)
+			{
+				ids.erase(it);
+				break;
+			}
+		}
+	}
+	evt.event = Event(nullptr);
+	evt.state = State::Free;
+	evt.version++;
+	freeEvents.push_back(idx);
+}
+
+void EventManager::remove(const std::string& id)
+{
+	if (id.empty() == true)
+	{
+		return;
+	}
+	auto range = ids.equal_range(id);
+	std::vector<uint32_t> removed;
+	for (auto it = range.first; it != range.second; ++it)
+	{
+		removed.push_back(it->second);
+	}
+	for (auto idx : removed)
+	{
+		release(idx);
+	}
+}
+
+void EventManager::resetTime(const std::string& id)
+{
+	if (id.empty() == true)
+	{
+		return;
+	}
+	auto range = ids.equal_range(id);
+	for (auto it = range.first; it != range.second; ++it)
+	{
+		auto& evt = events[it->second];
+		evt.startTime = getStartTime(evt.order);
+		if (evt.state == State::Deferred ||
+			(evt.state == State::Due &&
+				evt.startTime + evt.event.getTimeout() <= updateTime))
+		{
+			// still runs when it was going to
+			continue;
+		}
+		// replaces the heap entry (or the pending run this frame)
+		schedule(it->second);
+	}
+}
+
+void EventManager::update(Game& game)
+{
+	auto newTime = currentTime + game.getElapsedTime();
+	auto newTimeUs = newTime.asMicroseconds();
+	updateTime = newTime;
+	updateOrder = std::numeric_limits<int64_t>::min();
+	updating = true;
+
+	// events added while running the due ones can be due as well
+	while (true)
+	{
+		dueEvents.clear();
+		while (queue.empty() == false && queue.top().deadline <= newTimeUs)
+		{
+			auto entry = queue.top();
+			queue.pop();
+			auto& evt = events[entry.idx];
+			if (evt.version != entry.version ||
+				evt.state != State::Queued)
+			{
+				continue;
+			}
+			evt.state = State::Due;
+			dueEvents.push_back(std::make_pair(evt.order, entry.idx));
+		}
+		if (dueEvents.empty() == true)
+		{
+			break;
+		}
+		std::sort(dueEvents.begin(), dueEvents.end());
+
+		for (const auto& due : dueEvents)
+		{
+			auto idx = due.second;
+			if (events[idx].state != State::Due ||
+				events[idx].order != due.first)
+			{
+				// removed or rescheduled by an earlier event
+				continue;
+			}
+			updateOrder = due.first;
+			auto version = events[idx].version;
+			auto done = events[idx].event.execute(game);
+
+			auto& evt = events[idx];
+			if (evt.state == State::Free ||
+				evt.order != due.first)
+			{
+				// removed by its own action
+				continue;
+			}
+			if (done == true)
+			{
+				release(idx);
+				continue;
+			}
+			if (evt.version != version)
+			{
+				// its own action reset the time
+				continue;
+			}
+			auto timeout = evt.event.getTimeout();
+			if (timeout != sf::Time::Zero)
+			{
+				// restart the timeout, but keep the remainder
+				auto elapsed = newTime - evt.startTime;
+				evt.startTime = newTime - sf::microseconds(
+					elapsed.asMicroseconds() % timeout.asMicroseconds());
+			}
+			else
+			{
+				evt.startTime = newTime;
+			}
+			schedule(idx);
+		}
+	}
+
+	updating = false;
+	for (auto idx : deferredEvents)
+	{
+		if (events[idx].state == State::Deferred)
+		{
+			schedule(idx);
+		}
+	}
+	deferredEvents.clear();
+
+	currentTime = newTime;
+}
@@ -1,79 +1,95 @@
 #pragma once
 
+#include <cstdint>
 #include <memory>
-#include <list>
+#include <queue>
 #include <SFML/System/Time.hpp>
 #include "Actions/Action.h"
 #include "Event.h"
+#include <string>
+#include <unordered_map>
+#include <vector>
 
+// Events are kept in a min-heap by deadline (the time their timeout runs
+// out), so only the events that are due are looked at every frame. Due
+// events run in the order they were added (events added to the front
+// first), once per frame. Ids are indexed, so exists, remove and
+// resetTime don't go through all the events.
 class EventManager
 {
 private:
-	std::list<Event> events;
-
-public:
-	void addBack(const Event& event_) { events.push_back(event_); }
-	void addBack(const std::shared_ptr<Action>& action) { events.push_back(Event(action)); }
-	void addFront(const Event& event_) { events.push_front(event_); }
-	void addFront(const std::shared_ptr<Action>& action) { events.push_front(Event(action)); }
-
-	bool exists(const std::string& id) const
+	enum class State : uint8_t
 	{
-		if (id.empty() == false)
-		{
-			for (auto& evt : events)
-			{
-				if (evt.getId() == id)
-				{
-					return true;
-				}
-			}
-		}
-		return false;
-	}
+		Free,
+		Queued,		// in the heap
+		Due,		// taken from the heap, runs this frame
+		Deferred	// runs again from next frame
+	};
 
-	void remove(const std::string& id)
+	struct ScheduledEvent
 	{
-		if (id.empty() == true)
-		{
-			return;
-		}
-		for (auto& evt : events)
-		{
-			if (evt.getId() == id)
-			{
-				evt = Event(nullptr);
-			}
-		}
-	}
+		Event event{ nullptr };
+		sf::Time startTime;		// the timeout counts from here
+		int64_t order{ 0 };
+		uint32_t version{ 0 };	// bumped when (re)scheduled or removed
+		State state{ State::Free };
+	};
 
-	void resetTime(const std::string& id)
+	struct QueueEntry
 	{
-		if (id.empty() == true)
-		{
-			return;
-		}
-		for (auto& evt : events)
+		sf::Int64 deadline;
+		int64_t order;
+		uint32_t idx;
+		uint32_t version;
+
+		bool operator>(const QueueEntry& other) const
 		{
-			if (evt.getId() == id)
+			if (deadline != other.deadline)
 			{
-				evt.resetTime();
+				return deadline > other.deadline;
 			}
+			return order > other.order;
 		}
-	}
+	};
+
+	std::vector<ScheduledEvent> events;
+	std::vector<uint32_t> freeEvents;
+	std::priority_queue<QueueEntry, std::vector<QueueEntry>, std::greater<QueueEntry>> queue;
+	std::unordered_multimap<std::string, uint32_t> ids;
+
+	std::vector<std::pair<int64_t, uint32_t>> dueEvents;
+	std::vector<uint32_t> deferredEvents;
+
+	sf::Time currentTime;
+	int64_t frontOrder{ 0 };
+	int64_t backOrder{ 0 };
+
+	// while updating, the time at the end of the frame and the order of
+	// the event being run (events before it are done for this frame).
+	sf::Time updateTime;
+	int64_t updateOrder{ 0 };
+	bool updating{ false };
 
-	void update(Game& game)
+	sf::Time getStartTime(int64_t order) const;
+
+	void add(const Event& event_, bool front);
+	void schedule(uint32_t idx);
+	void release(uint32_t idx);
+
+public:
+	void addBack(const Event& event_) { add(event_, false); }
+	void addBack(const std::shared_ptr<Action>& action) { add(Event(action), false); }
+	void addFront(const Event& event_) { add(event_, true); }
+	void addFront(const std::shared_ptr<Action>& action) { add(Event(action), true); }
+
+	bool exists(const std::string& id) const
 	{
-		for (auto it = events.begin(); it != events.end();)
-		{
-			if (it->update(game) == true)
-			{
-				it = events.erase(it);
-			}
-			else
-			{
-				++it;
-			}
-		}
+		return id.empty() == false && ids.find(id) != ids.end();
 	}
+
+	void remove(const std::string& id);
+
+	void resetTime(const std::string& id);
+
+	void update(Game& game);
 };
@@ -0,0 +1,120 @@
+#include "FileTemplateCache.h"
+#include <algorithm>
+#include "FileUtils.h"
+
+void FileTemplateCache::clear()
+{
+	templates.clear();
+	templateOrder.clear();
+}
+
+void FileTemplateCache::scan(Template& tmpl)
+{
+	const auto& text = tmpl.text;
+	size_t literalStart = 0;
+	size_t pos = 0;
+	while ((pos = text.find('{', pos)) != std::string::npos)
+	{
+		// {n}, without leading zeroes
+		size_t param = 0;
+		auto end = pos + 1;
+		while (end < text.size() &&
+			text[end] >= '0' && text[end] <= '9' &&
+			end - pos <= 9)
+		{
+			param = param * 10 + (size_t)(text[end] - '0');
+			end++;
+		}
+		if (end == pos + 1 ||
+			end >= text.size() ||
+			text[end] != '}' ||
+			text[pos + 1] == '0')
+		{
+			pos++;
+			continue;
+		}
+		if (pos > literalStart)
+		{
+			tmpl.segments.push_back({ literalStart, pos - literalStart, 0 });
+		}
+		tmpl.segments.push_back({ pos, end + 1 - pos, param });
+		pos = end + 1;
+		literalStart = pos;
+	}
+	if (literalStart < text.size())
+	{
+		tmpl.segments.push_back({ literalStart, text.size() - literalStart, 0 });
+	}
+}
+
+const FileTemplateCache::Template* FileTemplateCache::getTemplate(const std::string& fileName)
+{
+	if (FileUtils::readText(fileName.c_str(), readBuffer) == false)
+	{
+		return nullptr;
+	}
+	auto it = templates.find(fileName);
+	if (it != templates.end())
+	{
+		if (it->second->text == readBuffer)
+		{
+			return it->second.get();
+		}
+		// the file changed
+		templates.erase(it);
+		templateOrder.erase(std::find(templateOrder.begin(), templateOrder.end(), fileName));
+	}
+	auto tmpl = std::make_unique<Template>();
+	tmpl->text = readBuffer;
+	scan(*tmpl);
+
+	// the oldest files are removed first
+	while (templates.size() >= std::max(maxFiles, (size_t)1) &&
+		templateOrder.empty() == false)
+	{
+		templates.erase(templateOrder.front());
+		templateOrder.pop_front();
+	}
+	auto tmplPtr = tmpl.get();
+	templates.insert(std::make_pair(fileName, std::move(tmpl)));
+	templateOrder.push_back(fileName);
+	return tmplPtr;
+}
+
+bool FileTemplateCache::expand(const std::string& fileName,
+	const std::vector<std::string>& params, std::string& output)
+{
+	output.clear();
+	auto tmpl = getTemplate(fileName);
+	if (tmpl == nullptr)
+	{
+		return false;
+	}
+
+	size_t size = 0;
+	for (const auto& segment : tmpl->segments)
+	{
+		if (segment.param > 0 && segment.param <= params.size())
+		{
+			size += params[segment.param - 1].size();
+		}
+		else
+		{
+			size += segment.size;
+		}
+	}
+	output.reserve(size);
+
+	for (const auto& segment : tmpl->segments)
+	{
+		if (segment.param > 0 && segment.param <= params.size())
+		{
+			output.append(params[segment.param - 1]);
+		}
+		else
+		{
+			output.append(tmpl->text, segment.start, segment.size);
+		}
+	}
+	return true;
+}
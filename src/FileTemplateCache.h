@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Expands the {1}, {2}, ... markers of a file with parameters in a single
+// pass into a pre-sized buffer. The scan of each file (its literal and
+// marker segments) is cached, so loading the same file again only checks
+// that its text didn't change and copies the segments.
+class FileTemplateCache
+{
+private:
+	struct Segment
+	{
+		// position and size in text (with the braces for markers)
+		size_t start;
+		size_t size;
+		// marker number or 0 for literals
+		size_t param;
+	};
+
+	struct Template
+	{
+		std::string text;
+		std::vector<Segment> segments;
+	};
+
+	std::unordered_map<std::string, std::unique_ptr<Template>> templates;
+	std::deque<std::string> templateOrder;
+	size_t maxFiles{ 32 };
+	std::string readBuffer;
+
+	static void scan(Template& tmpl);
+	const Template* getTemplate(const std::string& fileName);
+
+public:
+	size_t MaxFiles() const { return maxFiles; }
+	void MaxFiles(size_t maxFiles_) { maxFiles = maxFiles_; }
+
+	void clear();
+
+	// replaces output with the text of fileName, where {n} is replaced by
+	// params[n - 1]. Markers without a parameter are kept as they are.
+	// returns false if the file can't be read.
+	bool expand(const std::string& fileName,
+		const std::vector<std::string>& params, std::string& output);
+};
@@ -148,6 +148,36 @@ namespace FileUtils
 		return fileName.substr(0, pos);
 	}
 
+	bool getFileStats(const char* fileName, uint64_t& size, int64_t& modTime)
+	{
+#if (PHYSFS_VER_MAJOR > 2 || (PHYSFS_VER_MAJOR == 2 && PHYSFS_VER_MINOR >= 1))
+		PHYSFS_Stat fileStat;
+		if (PHYSFS_stat(fileName, &fileStat) == 0 ||
+			fileStat.filetype == PHYSFS_FILETYPE_DIRECTORY ||
+			fileStat.filesize < 0)
+		{
+			return false;
+		}
+		size = (uint64_t)fileStat.filesize;
+		modTime = (int64_t)fileStat.modtime;
+#else
+		auto file = PHYSFS_openRead(fileName);
+		if (file == NULL)
+		{
+			return false;
+		}
+		auto fileSize = PHYSFS_fileLength(file);
+		PHYSFS_close(file);
+		if (fileSize < 0)
+		{
+			return false;
+		}
+		size = (uint64_t)fileSize;
+		modTime = (int64_t)PHYSFS_getLastModTime(fileName);
+#endif
+		return true;
+	}
+
 	std::vector<std::string> getSaveDirList()
 	{
 		std::vector<std::string> vecDirs;
@@ -194,15 +224,25 @@ namespace FileUtils
 
 	std::string readText(const char* fileName)
 	{
+		std::string text;
+		readText(fileName, text);
+		return text;
+	}
+
+	bool readText(const char* fileName, std::string& text)
+	{
+		text.clear();
 		sf::PhysFSStream ifs(fileName);
 		if (ifs.hasError() == true)
 		{
-			return "";
+			return false;
 		}
-		auto data = std::make_unique<char[]>((size_t)ifs.getSize());
-		ifs.read(data.get(), ifs.getSize());
-
-		return std::string(data.get(), (unsigned)ifs.getSize());
+		text.resize((size_t)ifs.getSize());
+		if (text.empty() == false)
+		{
+			ifs.read(&text[0], ifs.getSize());
+		}
+		return true;
 	}
 
 	std::vector<uint8_t> readChar(const char* fileName)
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <string>
 #include <vector>
 
@@ -19,9 +20,14 @@ namespace FileUtils
 
 	std::string getFileWithoutExt(const std::string& fileName);
 
+	// gets the size and the last modification time of a file without reading it.
+	bool getFileStats(const char* fileName, uint64_t& size, int64_t& modTime);
+
 	std::vector<std::string> getSaveDirList();
 
 	std::string readText(const char* fileName);
+	// reads into text, reusing its capacity.
+	bool readText(const char* fileName, std::string& text);
 
 	std::vector<uint8_t> readChar(const char* fileName);
 	std::vector<uint8_t> readChar(const char* fileName, size_t maxNumBytes);
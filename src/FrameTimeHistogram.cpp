@@ -0,0 +1,78 @@
+#include "FrameTimeHistogram.h"
+#include <algorithm>
+#include <cmath>
+
+size_t FrameTimeHistogram::getBucket(int64_t time)
+{
+	auto value = (uint64_t)std::max(time, (int64_t)0);
+	unsigned shift = 0;
+	while ((value >> shift) >= (uint64_t)(subBuckets * 2))
+	{
+		shift++;
+	}
+	return (size_t)shift * (size_t)subBuckets + (size_t)(value >> shift);
+}
+
+int64_t FrameTimeHistogram::getBucketTime(size_t bucket)
+{
+	size_t shift = 0;
+	if (bucket >= (size_t)(subBuckets * 2))
+	{
+		shift = bucket / (size_t)subBuckets - 1;
+	}
+	auto lower = (int64_t)(bucket - shift * (size_t)subBuckets) << shift;
+	// the middle of the bucket
+	return lower + (((int64_t)1 << shift) - 1) / 2;
+}
+
+void FrameTimeHistogram::add(int64_t time)
+{
+	auto bucket = getBucket(time);
+	if (bucket >= buckets.size())
+	{
+		buckets.resize(bucket + 1);
+	}
+	buckets[bucket]++;
+	if (count == 0)
+	{
+		min = time;
+		max = time;
+	}
+	else
+	{
+		min = std::min(min, time);
+		max = std::max(max, time);
+	}
+	count++;
+	total += time;
+}
+
+void FrameTimeHistogram::clear()
+{
+	buckets.clear();
+	count = 0;
+	total = 0;
+	min = 0;
+	max = 0;
+}
+
+int64_t FrameTimeHistogram::getPercentile(double p) const
+{
+	if (count == 0)
+	{
+		return 0;
+	}
+	// same rank as sorting all the times and taking ceil(count * p / 100)
+	auto rank = (uint64_t)std::ceil((double)count * p / 100.0);
+	rank = std::min(std::max(rank, (uint64_t)1), count);
+	uint64_t seen = 0;
+	for (size_t i = 0; i < buckets.size(); i++)
+	{
+		seen += buckets[i];
+		if (seen >= rank)
+		{
+			return std::min(std::max(getBucketTime(i), min), max);
+		}
+	}
+	return max;
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Frame times (microseconds) in a fixed number of buckets, so long runs
+// don't grow memory. Each power of two is split in subBuckets buckets,
+// which keeps the percentiles within about 1.6% of the real times.
+// The count, total, min and max are exact.
+class FrameTimeHistogram
+{
+private:
+	static const unsigned subBucketBits = 6;
+	static const int64_t subBuckets = 1 << subBucketBits;
+
+	std::vector<uint64_t> buckets;
+	uint64_t count{ 0 };
+	int64_t total{ 0 };
+	int64_t min{ 0 };
+	int64_t max{ 0 };
+
+	static size_t getBucket(int64_t time);
+	static int64_t getBucketTime(size_t bucket);
+
+public:
+	void add(int64_t time);
+	void clear();
+
+	bool empty() const { return count == 0; }
+	uint64_t Count() const { return count; }
+	int64_t Total() const { return total; }
+	int64_t Min() const { return min; }
+	int64_t Max() const { return max; }
+
+	// the time that p percent of the frames don't go over (p in 0-100).
+	int64_t getPercentile(double p) const;
+};
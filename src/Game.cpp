@@ -1,11 +1,15 @@
 #include "Game.h"
 #include "GameUtils.h"
+#include <iterator>
 #include "Json/JsonUtils.h"
 #include "Parser/ParseVariable.h"
 #include "ReverseIterable.h"
 #include "SFMLUtils.h"
 #include "Utils.h"
 
+// most updates to run in a single frame with a fixed timestep
+static const sf::Int64 maxTicksPerFrame = 5;
+
 Game::~Game()
 {
 	resourceManager = ResourceManager();
@@ -15,10 +19,34 @@ Game::~Game()
 	}
 }
 
+void Game::setHeadless(bool draw, const sf::Time& frameTime,
+	uint64_t maxFrames, const sf::Time& maxTime)
+{
+	if (isRunning() == true)
+	{
+		return;
+	}
+	headless = true;
+	headlessDraw = draw;
+	headlessFrameTime = frameTime;
+	headlessMaxFrames = maxFrames;
+	headlessMaxTime = maxTime;
+}
+
 void Game::init()
 {
-	if (window.isOpen() == true)
+	if (isRunning() == true)
+	{
+		return;
+	}
+	if (headless == true)
 	{
+		oldSize = size;
+		headlessRunning = true;
+		if (headlessDraw == true)
+		{
+			updateWindowTex();
+		}
 		return;
 	}
 #ifdef __ANDROID__
@@ -41,101 +69,235 @@ void Game::init()
 	updateWindowTex();
 }
 
+bool Game::isRunning() const
+{
+	if (headless == true)
+	{
+		return headlessRunning;
+	}
+	return window.isOpen();
+}
+
+bool Game::hasHeadlessLimit(uint64_t frames, const sf::Time& time) const
+{
+	return (headlessMaxFrames > 0 && frames >= headlessMaxFrames) ||
+		(headlessMaxTime > sf::Time::Zero && time >= headlessMaxTime);
+}
+
+void Game::close()
+{
+	headlessRunning = false;
+	window.close();
+}
+
 void Game::play()
 {
-	if (window.isOpen() == false)
+	if (isRunning() == false)
 	{
 		return;
 	}
 
-	updateMouse();
+	if (inputReplay != nullptr)
+	{
+		// same size as the recording, since drawables are laid out with it
+		const auto& replaySize = inputReplay->WindowSize();
+		if (replaySize != size && replaySize.x > 0 && replaySize.y > 0)
+		{
+			sf::Event::SizeEvent sizeEvt;
+			sizeEvt.width = replaySize.x;
+			sizeEvt.height = replaySize.y;
+			onResized(sizeEvt);
+		}
+		updateMouse(inputReplay->MousePosition());
+	}
+	else
+	{
+		updateMouse();
+	}
+	if (inputRecorder != nullptr)
+	{
+		inputRecorder->MousePosition(mousePositioni);
+		inputRecorder->WindowSize(size);
+	}
 	sf::Clock frameClock;
+	uint64_t numFrames = 0;
+	sf::Time totalTime;
 
-	while (window.isOpen() == true)
+	while (isRunning() == true)
 	{
-		processEvents();
+		if (headless == true &&
+			hasHeadlessLimit(numFrames, totalTime) == true)
+		{
+			break;
+		}
 
-		window.clear();
-		windowTex.clear();
+		profiler.beginFrame();
 
-		elapsedTime = frameClock.restart();
+		processEvents();
+		if (isRunning() == false)
+		{
+			break;
+		}
 
-		updateEvents();
+		if (headless == false)
+		{
+			window.clear();
+			windowTex.clear();
+			elapsedTime = frameClock.restart();
+		}
+		else
+		{
+			if (headlessDraw == true)
+			{
+				windowTex.clear();
+			}
+			elapsedTime = headlessFrameTime;
+			frameClock.restart();
+		}
+		if (inputReplay != nullptr)
+		{
+			elapsedTime = inputReplay->ElapsedTime();
+		}
+		else if (inputRecorder != nullptr)
+		{
+			inputRecorder->addFrame(elapsedTime);
+		}
+
+		if (tickRate == 0)
+		{
+			updateEvents();
+			if (loadingScreen == nullptr)
+			{
+				updateDrawables();
+			}
+		}
+		else
+		{
+			updateTicks();
+		}
 
 		resourceManager.clearFinishedSounds();
 
 		if (drawLoadingScreen() == false)
 		{
-			drawAndUpdate();
+			drawDrawables();
 			drawCursor();
 			drawFadeEffect();
 			drawWindow();
 		}
+
+		profiler.endFrame();
+
+		if (headless == true)
+		{
+			frameTimes.add(frameClock.getElapsedTime().asMicroseconds());
+			numFrames++;
+			totalTime += headlessFrameTime;
+		}
 	}
 }
 
 void Game::processEvents()
 {
-	mousePressed = false;
-	mouseReleased = false;
-	mouseMoved = false;
-	mouseScrolled = false;
-	keyPressed = false;
-	textEntered = false;
+	ProfilerScope scope(profiler, "processEvents");
+
+	if (keepInputEvents == false)
+	{
+		mousePressed = false;
+		mouseReleased = false;
+		mouseMoved = false;
+		mouseScrolled = false;
+		keyPressed = false;
+		textEntered = false;
+	}
 
 	sf::Event evt;
+	if (inputReplay != nullptr)
+	{
+		// the window can still be closed, the rest comes from the recording
+		while (window.pollEvent(evt))
+		{
+			if (evt.type == sf::Event::Closed)
+			{
+				onClosed();
+			}
+		}
+		if (inputReplay->nextFrame() == false)
+		{
+			close();
+			return;
+		}
+		for (const auto& replayEvt : inputReplay->Events())
+		{
+			processEvent(replayEvt);
+		}
+		return;
+	}
 	while (window.pollEvent(evt))
 	{
-		switch (evt.type)
+		if (inputRecorder != nullptr)
 		{
-		case sf::Event::Closed:
-			onClosed();
-			break;
-		case sf::Event::Resized:
-			onResized(evt.size);
-			break;
-		case sf::Event::LostFocus:
-			onLostFocus();
-			break;
-		case sf::Event::GainedFocus:
-			onGainedFocus();
-			break;
-		case sf::Event::TextEntered:
-			onTextEntered(evt.text);
-			break;
-		case sf::Event::KeyPressed:
-			onKeyPressed(evt.key);
-			break;
-		case sf::Event::MouseWheelScrolled:
-			onMouseWheelScrolled(evt.mouseWheelScroll);
-			break;
-		case sf::Event::MouseButtonPressed:
-			onMouseButtonPressed(evt.mouseButton);
-			break;
-		case sf::Event::MouseButtonReleased:
-			onMouseButtonReleased(evt.mouseButton);
-			break;
-		case sf::Event::MouseMoved:
-			onMouseMoved(evt.mouseMove);
-			break;
-		case sf::Event::TouchBegan:
-			onTouchBegan(evt.touch);
-			break;
-		case sf::Event::TouchMoved:
-			onTouchMoved(evt.touch);
-			break;
-		case sf::Event::TouchEnded:
-			onTouchEnded(evt.touch);
-			break;
-		default:
-			break;
+			inputRecorder->addEvent(mapEventToCoords(evt));
 		}
+		processEvent(evt);
+	}
+}
+
+void Game::processEvent(const sf::Event& evt)
+{
+	switch (evt.type)
+	{
+	case sf::Event::Closed:
+		onClosed();
+		break;
+	case sf::Event::Resized:
+		onResized(evt.size);
+		break;
+	case sf::Event::LostFocus:
+		onLostFocus();
+		break;
+	case sf::Event::GainedFocus:
+		onGainedFocus();
+		break;
+	case sf::Event::TextEntered:
+		onTextEntered(evt.text);
+		break;
+	case sf::Event::KeyPressed:
+		onKeyPressed(evt.key);
+		break;
+	case sf::Event::MouseWheelScrolled:
+		onMouseWheelScrolled(evt.mouseWheelScroll);
+		break;
+	case sf::Event::MouseButtonPressed:
+		onMouseButtonPressed(evt.mouseButton);
+		break;
+	case sf::Event::MouseButtonReleased:
+		onMouseButtonReleased(evt.mouseButton);
+		break;
+	case sf::Event::MouseMoved:
+		onMouseMoved(evt.mouseMove);
+		break;
+	case sf::Event::TouchBegan:
+		onTouchBegan(evt.touch);
+		break;
+	case sf::Event::TouchMoved:
+		onTouchMoved(evt.touch);
+		break;
+	case sf::Event::TouchEnded:
+		onTouchEnded(evt.touch);
+		break;
+	case sf::Event::Count:
+		// a recorded mouse position that changed without an event
+		updateMouse(sf::Vector2i(evt.mouseMove.x, evt.mouseMove.y));
+		break;
+	default:
+		break;
 	}
 }
 
 void Game::onClosed()
 {
-	window.close();
+	close();
 }
 
 void Game::onResized(const sf::Event::SizeEvent& evt)
@@ -160,7 +322,10 @@ void Game::onResized(const sf::Event::SizeEvent& evt)
 	oldSize = size;
 	size = newSize;
 
-	updateWindowTex();
+	if (headless == false || headlessDraw == true)
+	{
+		updateWindowTex();
+	}
 
 	auto view = window.getView();
 	if (stretchToFit == false)
@@ -267,7 +432,7 @@ void Game::onMouseWheelScrolled(const sf::Event::MouseWheelScrollEvent& evt)
 	}
 	mouseScrollEvt = evt;
 	mouseScrolled = true;
-	updateMouse();
+	updateMouse(sf::Vector2i(evt.x, evt.y));
 }
 
 void Game::onMouseButtonPressed(const sf::Event::MouseButtonEvent& evt)
@@ -334,14 +499,64 @@ void Game::onTouchEnded(const sf::Event::TouchEvent& evt)
 
 void Game::updateMouse()
 {
+	if (headless == true || inputReplay != nullptr)
+	{
+		// there's no mouse without a window and replays have their own
+		return;
+	}
 	updateMouse(sf::Mouse::getPosition(window));
+	if (inputRecorder != nullptr)
+	{
+		inputRecorder->addMousePosition(mousePositioni);
+	}
+}
+
+sf::Vector2f Game::mapPixelToCoords(const sf::Vector2i& mousePos) const
+{
+	if (headless == true || inputReplay != nullptr)
+	{
+		// replays are recorded in game coordinates
+		return sf::Vector2f((float)mousePos.x, (float)mousePos.y);
+	}
+	auto coords = window.mapPixelToCoords(mousePos);
+	return sf::Vector2f(std::round(coords.x), std::round(coords.y));
+}
+
+sf::Event Game::mapEventToCoords(const sf::Event& evt) const
+{
+	auto mapped = evt;
+	auto mapPos = [this](int& x, int& y)
+	{
+		auto coords = mapPixelToCoords(sf::Vector2i(x, y));
+		x = (int)coords.x;
+		y = (int)coords.y;
+	};
+	switch (mapped.type)
+	{
+	case sf::Event::MouseWheelScrolled:
+		mapPos(mapped.mouseWheelScroll.x, mapped.mouseWheelScroll.y);
+		break;
+	case sf::Event::MouseButtonPressed:
+	case sf::Event::MouseButtonReleased:
+		mapPos(mapped.mouseButton.x, mapped.mouseButton.y);
+		break;
+	case sf::Event::MouseMoved:
+		mapPos(mapped.mouseMove.x, mapped.mouseMove.y);
+		break;
+	case sf::Event::TouchBegan:
+	case sf::Event::TouchMoved:
+	case sf::Event::TouchEnded:
+		mapPos(mapped.touch.x, mapped.touch.y);
+		break;
+	default:
+		break;
+	}
+	return mapped;
 }
 
 void Game::updateMouse(const sf::Vector2i mousePos)
 {
-	mousePositionf = window.mapPixelToCoords(mousePos);
-	mousePositionf.x = std::round(mousePositionf.x);
-	mousePositionf.y = std::round(mousePositionf.y);
+	mousePositionf = mapPixelToCoords(mousePos);
 	mousePositioni.x = (int)mousePositionf.x;
 	mousePositioni.y = (int)mousePositionf.y;
 	updateCursorPosition();
@@ -358,6 +573,7 @@ void Game::updateCursorPosition()
 
 void Game::updateEvents()
 {
+	ProfilerScope scope(profiler, "events");
 	if (paused == false)
 	{
 		eventManager.update(*this);
@@ -370,34 +586,214 @@ bool Game::drawLoadingScreen()
 	{
 		return false;
 	}
-	windowTex.draw(*loadingScreen);
+	ProfilerScope scope(profiler, "loadingScreen");
+	if (isDrawing() == true)
+	{
+		windowTex.draw(*loadingScreen);
+	}
 	drawFadeEffect();
 	drawWindow();
 	return true;
 }
 
-void Game::drawAndUpdate()
+void Game::updateTicks()
 {
+	// updates that take longer than a tick only slow the game down,
+	// instead of making the next frames run even more updates.
+	auto frameTime = elapsedTime;
+	tickAccumulator = std::min(tickAccumulator + frameTime,
+		sf::microseconds(tickTime.asMicroseconds() * maxTicksPerFrame));
+
+	elapsedTime = tickTime;
+	bool ticked = false;
+	while (tickAccumulator >= tickTime)
+	{
+		tickAccumulator -= tickTime;
+		if (ticked == true)
+		{
+			// only the first update of a frame gets the input events
+			clearInputEvents();
+		}
+		updateEvents();
+		if (loadingScreen == nullptr)
+		{
+			updateDrawables();
+		}
+		ticked = true;
+	}
+	keepInputEvents = (ticked == false);
+
+	// the cursor and the fade effect are updated once per frame
+	elapsedTime = frameTime;
+
+	if (loadingScreen == nullptr)
+	{
+		auto alpha = (float)tickAccumulator.asMicroseconds() / (float)tickTime.asMicroseconds();
+		interpolateDrawables(paused == false ? alpha : 1.f);
+	}
+}
+
+static bool rectContains(const sf::FloatRect& rect, const sf::FloatRect& rect2)
+{
+	return (rect.left <= rect2.left &&
+		rect.top <= rect2.top &&
+		rect.left + rect.width >= rect2.left + rect2.width &&
+		rect.top + rect.height >= rect2.top + rect2.height);
+}
+
+void Game::updateOcclusion()
+{
+	occludedBundles.clear();
+	if (occlusion == false)
+	{
+		return;
+	}
+	occludedBundles.resize(std::distance(resourceManager.begin(), resourceManager.end()), false);
+	opaqueRects.clear();
+	sf::FloatRect screenRect(0.f, 0.f, (float)windowTexSize.x, (float)windowTexSize.y);
+	auto covered = [this](const sf::FloatRect& rect)
+	{
+		for (const auto& opaqueRect : opaqueRects)
+		{
+			if (rectContains(opaqueRect, rect) == true)
+			{
+				return true;
+			}
+		}
+		return false;
+	};
+
+	// from the top bundle down, a bundle is occluded if all its visible
+	// drawables are inside an opaque rect of the bundles above it
+	auto idx = occludedBundles.size();
+	for (const auto& res : reverse(resourceManager))
+	{
+		idx--;
+		if (res.ignore == IgnoreResource::DrawAndUpdate)
+		{
+			continue;
+		}
+		if (covered(screenRect) == true)
+		{
+			occludedBundles[idx] = true;
+			continue;
+		}
+		if (opaqueRects.empty() == false)
+		{
+			bool bundleCovered = true;
+			for (const auto& obj : res.drawables)
+			{
+				if (obj.second->Visible() == true &&
+					covered(sf::FloatRect(obj.second->DrawPosition(), obj.second->Size())) == false)
+				{
+					bundleCovered = false;
+					break;
+				}
+			}
+			if (bundleCovered == true)
+			{
+				occludedBundles[idx] = true;
+				continue;
+			}
+		}
+		if (res.opaque == true)
+		{
+			if (res.opaqueRect.width > 0.f && res.opaqueRect.height > 0.f)
+			{
+				opaqueRects.push_back(res.opaqueRect);
+			}
+			else
+			{
+				opaqueRects.push_back(screenRect);
+			}
+		}
+		sf::FloatRect rect;
+		for (const auto& obj : res.drawables)
+		{
+			if (obj.second->getOpaqueRect(rect) == true)
+			{
+				opaqueRects.push_back(rect);
+			}
+		}
+	}
+}
+
+bool Game::isOccluded(size_t bundleIdx) const
+{
+	return bundleIdx < occludedBundles.size() && occludedBundles[bundleIdx] == true;
+}
+
+void Game::updateDrawables()
+{
+	ProfilerScope scope(profiler, "update");
+	if (occlusionUpdate == true)
+	{
+		updateOcclusion();
+	}
+	auto idx = (size_t)std::distance(resourceManager.begin(), resourceManager.end());
 	for (auto& res : reverse(resourceManager))
 	{
+		idx--;
 		if (res.ignore != IgnoreResource::DrawAndUpdate)
 		{
+			if (occlusionUpdate == true && isOccluded(idx) == true)
+			{
+				ProfilerScope occludedScope(profiler, "occluded");
+				ProfilerScope resScope(profiler, res.id);
+				continue;
+			}
+			ProfilerScope resScope(profiler, res.id);
 			for (auto it2 = res.drawables.rbegin(); it2 != res.drawables.rend(); ++it2)
 			{
 				auto& obj = *(it2);
 				if (paused == false && res.ignore != IgnoreResource::Update)
 				{
+					ProfilerScope objScope(profiler, obj.first);
 					obj.second->update(*this);
 				}
 			}
 		}
 	}
+}
+
+void Game::interpolateDrawables(float alpha)
+{
+	for (auto& res : resourceManager)
+	{
+		if (res.ignore != IgnoreResource::DrawAndUpdate)
+		{
+			for (auto& obj : res.drawables)
+			{
+				obj.second->interpolate(res.ignore != IgnoreResource::Update ? alpha : 1.f);
+			}
+		}
+	}
+}
+
+void Game::drawDrawables()
+{
+	if (isDrawing() == false)
+	{
+		return;
+	}
+	ProfilerScope scope(profiler, "draw");
+	updateOcclusion();
+	size_t idx = 0;
 	for (auto& res : resourceManager)
 	{
+		auto bundleIdx = idx++;
 		if (res.ignore != IgnoreResource::DrawAndUpdate)
 		{
+			if (isOccluded(bundleIdx) == true)
+			{
+				ProfilerScope occludedScope(profiler, "occluded");
+				ProfilerScope resScope(profiler, res.id);
+				continue;
+			}
+			ProfilerScope resScope(profiler, res.id);
 			for (auto& obj : res.drawables)
 			{
+				ProfilerScope objScope(profiler, obj.first);
 				windowTex.draw(*obj.second);
 			}
 		}
@@ -406,28 +802,43 @@ void Game::drawAndUpdate()
 
 void Game::drawCursor()
 {
+	ProfilerScope scope(profiler, "cursor");
 	auto cursor = resourceManager.getCursor();
 	if (cursor != nullptr)
 	{
 		cursor->update(*this);
-		windowTex.draw(*cursor);
+		if (isDrawing() == true)
+		{
+			windowTex.draw(*cursor);
+		}
 	}
 }
 
 void Game::drawFadeEffect()
 {
+	ProfilerScope scope(profiler, "fade");
 	if (fadeInOut != nullptr)
 	{
-		windowTex.draw(static_cast<sf::RectangleShape>(*fadeInOut));
+		if (isDrawing() == true)
+		{
+			windowTex.draw(static_cast<sf::RectangleShape>(*fadeInOut));
+		}
 		fadeInOut->update(*this);
 	}
 }
 
 void Game::drawWindow()
 {
-	windowTex.display();
-	window.draw(windowSprite);
-	window.display();
+	ProfilerScope scope(profiler, "present");
+	if (isDrawing() == true)
+	{
+		windowTex.display();
+	}
+	if (headless == false)
+	{
+		window.draw(windowSprite);
+		window.display();
+	}
 }
 
 void Game::SmoothScreen(bool smooth_)
@@ -520,35 +931,12 @@ void Game::addPlayingSound(const sf::SoundBuffer* obj)
 
 bool Game::getVariableNoPercentage(const std::string& key, Variable& var) const
 {
-	auto it = variables.find(key);
-	if (it != variables.cend())
-	{
-		var = it->second;
-		return true;
-	}
-	return false;
+	return variables.get(variables.findId(key), var);
 }
 
 bool Game::getVariable(const std::string& key, Variable& var) const
 {
-	auto it = findVariable(key);
-	if (it != variables.cend())
-	{
-		var = it->second;
-		return true;
-	}
-	return false;
-}
-
-std::map<std::string, Variable>::const_iterator Game::findVariable(const std::string& key) const
-{
-	if ((key.size() > 2) &&
-		(key.front() == '%') &&
-		(key.back() == '%'))
-	{
-		return variables.find(key.substr(1, key.size() - 2));
-	}
-	return variables.end();
+	return variables.get(variables.findIdPercentage(key), var);
 }
 
 bool Game::getVarOrProp(const std::string& key, Variable& var) const
@@ -658,22 +1046,12 @@ std::string Game::getVarOrPropString(const Variable& var) const
 
 void Game::clearVariable(const std::string& key)
 {
-	if (key.size() > 1)
-	{
-		if ((key.front() == '%') && (key.back() == '%'))
-		{
-			auto it = variables.find(key.substr(1, key.size() - 2));
-			if (it != variables.end())
-			{
-				variables.erase(it);
-			}
-		}
-	}
+	variables.clear(variables.findIdPercentage(key));
 }
 
 void Game::setVariable(const std::string& key, const Variable& value)
 {
-	variables[key] = value;
+	variables.set(variables.getId(key), value);
 }
 
 void Game::saveVariables(const std::string& filePath, const std::vector<std::string>& varNames) const
@@ -685,10 +1063,10 @@ void Game::saveVariables(const std::string& filePath, const std::vector<std::str
 	std::vector<std::pair<std::string, Variable>> variablesToSave;
 	for (const auto& name : varNames)
 	{
-		auto it = variables.find(name);
-		if (it != variables.end())
+		Variable var;
+		if (variables.get(variables.findId(name), var) == true)
 		{
-			variablesToSave.push_back(*it);
+			variablesToSave.push_back(std::make_pair(name, var));
 		}
 	}
 	if (variablesToSave.empty() == false)
@@ -722,6 +1100,9 @@ bool Game::getProperty(const std::string& prop, Variable& var) const
 	case str2int16("keepAR"):
 		var = Variable((bool)keepAR);
 		break;
+	case str2int16("lazyResourcesMaxSize"):
+		var = Variable((int64_t)resourceManager.LazyMaxSize());
+		break;
 	case str2int16("minSize"):
 	{
 		if (props.second == "x")
@@ -737,9 +1118,20 @@ bool Game::getProperty(const std::string& prop, Variable& var) const
 	case str2int16("musicVolume"):
 		var = Variable((int64_t)musicVolume);
 		break;
+	case str2int16("occlusion"):
+		var = Variable(occlusion);
+		break;
+	case str2int16("occlusionUpdate"):
+		var = Variable(occlusionUpdate);
+		break;
+	case str2int16("parallelLoad"):
+		var = Variable(parallelLoad);
+		break;
 	case str2int16("path"):
 		var = Variable(path);
 		break;
+	case str2int16("profiler"):
+		return profiler.getProperty(props.second, var);
 	case str2int16("refSize"):
 	{
 		if (props.second == "x")
@@ -776,6 +1168,25 @@ bool Game::getProperty(const std::string& prop, Variable& var) const
 	case str2int16("stretchToFit"):
 		var = Variable((bool)stretchToFit);
 		break;
+	case str2int16("textBindings"):
+	{
+		if (props.second == "executed")
+		{
+			var = Variable((int64_t)textBindingStats.executed);
+		}
+		else if (props.second == "skipped")
+		{
+			var = Variable((int64_t)textBindingStats.skipped);
+		}
+		else
+		{
+			return false;
+		}
+		break;
+	}
+	case str2int16("tickRate"):
+		var = Variable((int64_t)tickRate);
+		break;
 	case str2int16("title"):
 		var = Variable(title);
 		break;
@@ -812,6 +1223,14 @@ void Game::setProperty(const std::string& prop, const Variable& val)
 		}
 	}
 	break;
+	case str2int16("lazyResourcesMaxSize"):
+	{
+		if (val.is<int64_t>() == true && val.get<int64_t>() >= 0)
+		{
+			resourceManager.LazyMaxSize((size_t)val.get<int64_t>());
+		}
+	}
+	break;
 	case str2int16("musicVolume"):
 	{
 		if (val.is<int64_t>() == true)
@@ -820,6 +1239,38 @@ void Game::setProperty(const std::string& prop, const Variable& val)
 		}
 	}
 	break;
+	case str2int16("occlusion"):
+	{
+		if (val.is<bool>() == true)
+		{
+			Occlusion(val.get<bool>());
+		}
+	}
+	break;
+	case str2int16("occlusionUpdate"):
+	{
+		if (val.is<bool>() == true)
+		{
+			OcclusionUpdate(val.get<bool>());
+		}
+	}
+	break;
+	case str2int16("parallelLoad"):
+	{
+		if (val.is<bool>() == true)
+		{
+			ParallelLoad(val.get<bool>());
+		}
+	}
+	break;
+	case str2int16("profiler"):
+	{
+		if (val.is<bool>() == true)
+		{
+			profiler.Enabled(val.get<bool>());
+		}
+	}
+	break;
 	case str2int16("smoothScreen"):
 	{
 		if (val.is<bool>() == true)
@@ -844,6 +1295,14 @@ void Game::setProperty(const std::string& prop, const Variable& val)
 		}
 	}
 	break;
+	case str2int16("tickRate"):
+	{
+		if (val.is<int64_t>() == true)
+		{
+			TickRate((unsigned)val.get<int64_t>());
+		}
+	}
+	break;
 	case str2int16("title"):
 	{
 		if (val.is<std::string>() == true)
@@ -2,17 +2,25 @@
 
 #include "EventManager.h"
 #include "FadeInOut.h"
+#include "FileTemplateCache.h"
+#include "FrameTimeHistogram.h"
 #include "Game/Level.h"
+#include "InputRecorder.h"
+#include "Json/JsonCache.h"
 #include "LoadingScreen.h"
 #include <memory>
 #include "Menu.h"
 #include "Parser/ParseVariable.h"
+#include "ParseTracer.h"
+#include "Profiler.h"
 #include "Queryable.h"
 #include "ResourceManager.h"
 #include <string>
 #include <SFML/Audio.hpp>
 #include <SFML/Graphics.hpp>
+#include "TextBindings.h"
 #include "Variable.h"
+#include "VariableStore.h"
 #include <vector>
 
 class Game : public sf::NonCopyable, public Queryable
@@ -62,19 +70,55 @@ private:
 
 	sf::Time elapsedTime;
 
+	// fixed timestep (updates per second, 0 to update once per frame)
+	unsigned tickRate{ 0 };
+	sf::Time tickTime;
+	sf::Time tickAccumulator;
+	// keeps the input events for the next frame if no update ran
+	bool keepInputEvents{ false };
+
+	// skips drawing (and updating, if occlusionUpdate) the bundles hidden
+	// by opaque bundles or drawables above them
+	bool occlusion{ true };
+	bool occlusionUpdate{ false };
+
+	// decodes the resources of the parsed files on worker threads
+	bool parallelLoad{ false };
+	std::vector<bool> occludedBundles;
+	std::vector<sf::FloatRect> opaqueRects;
+
+	// runs without a window (benchmarks, soak tests)
+	bool headless{ false };
+	bool headlessDraw{ false };
+	bool headlessRunning{ false };
+	sf::Time headlessFrameTime;
+	uint64_t headlessMaxFrames{ 0 };
+	sf::Time headlessMaxTime;
+	// real time of the frames in headless mode
+	FrameTimeHistogram frameTimes;
+
+	std::unique_ptr<InputRecorder> inputRecorder;
+	std::unique_ptr<InputReplay> inputReplay;
+
 	std::string path;
 	std::string title;
 	std::string version;
 
 	ResourceManager resourceManager;
 	EventManager eventManager;
+	Profiler profiler;
+	TextBindingStats textBindingStats;
+	JsonCache jsonCache;
+	FileTemplateCache fileTemplates;
+	ParseTracer parseTracer;
 
-	std::map<std::string, Variable> variables;
+	VariableStore variables;
 
 	std::unique_ptr<LoadingScreen> loadingScreen;
 	std::unique_ptr<FadeInOut> fadeInOut;
 
 	void processEvents();
+	void processEvent(const sf::Event& evt);
 	void onClosed();
 	void onResized(const sf::Event::SizeEvent& evt);
 	void onLostFocus();
@@ -90,17 +134,26 @@ private:
 	void onTouchMoved(const sf::Event::TouchEvent& evt);
 	void onTouchEnded(const sf::Event::TouchEvent& evt);
 
+	sf::Vector2f mapPixelToCoords(const sf::Vector2i& mousePos) const;
+	sf::Event mapEventToCoords(const sf::Event& evt) const;
 	void updateMouse(const sf::Vector2i mousePos);
 	void updateEvents();
+	void updateTicks();
+	void updateOcclusion();
+	bool isOccluded(size_t bundleIdx) const;
+	void updateDrawables();
+	void interpolateDrawables(float alpha);
 	void drawCursor();
-	void drawAndUpdate();
+	void drawDrawables();
 	void drawFadeEffect();
 	void drawWindow();
 
 	void updateSize();
 	void updateWindowTex();
 
-	std::map<std::string, Variable>::const_iterator findVariable(const std::string& key) const;
+	bool isRunning() const;
+	bool isDrawing() const { return headless == false || headlessDraw == true; }
+	bool hasHeadlessLimit(uint64_t frames, const sf::Time& time) const;
 
 public:
 	Game() : refSize(640, 480), minSize(640, 480), size(640, 480) {}
@@ -108,6 +161,24 @@ public:
 
 	void init();
 
+	// must be set before init. Frames are updated with frameTime and the
+	// game stops after maxFrames or maxTime of frames (0 to not stop).
+	// Drawing goes to the window texture or is skipped.
+	void setHeadless(bool draw, const sf::Time& frameTime,
+		uint64_t maxFrames, const sf::Time& maxTime);
+	bool isHeadless() const { return headless; }
+	const FrameTimeHistogram& getFrameTimes() const { return frameTimes; }
+
+	// must be set before play. While replaying, the window's input is ignored
+	// and the game closes at the end of the recording.
+	void setInputRecorder(std::unique_ptr<InputRecorder> recorder) { inputRecorder = std::move(recorder); }
+	void setInputReplay(std::unique_ptr<InputReplay> replay) { inputReplay = std::move(replay); }
+	// work that can finish on a different frame each run (path finder
+	// thread, parallel loading) is done on the main thread while true.
+	bool isRecordingOrReplaying() const { return inputRecorder != nullptr || inputReplay != nullptr; }
+
+	void close();
+
 	const sf::Vector2u& OldWindowSize() const { return oldSize; }
 	const sf::Vector2u& WindowSize() const { return size; }
 	const sf::Vector2u& WindowTexSize() const { return windowTexSize; }
@@ -153,9 +224,14 @@ public:
 		}
 	}
 	unsigned Framerate() const { return framerate; }
+	unsigned TickRate() const { return tickRate; }
 	bool SmoothScreen() const { return smoothScreen; }
 	bool StretchToFit() const { return stretchToFit; }
 	bool KeepAR() const { return keepAR; }
+	bool Occlusion() const { return occlusion; }
+	bool OcclusionUpdate() const { return occlusionUpdate; }
+	// off while recording or replaying input
+	bool ParallelLoad() const { return parallelLoad == true && isRecordingOrReplaying() == false; }
 
 	const sf::Vector2i& MousePositioni() const { return mousePositioni; }
 	const sf::Vector2f& MousePositionf() const { return mousePositionf; }
@@ -220,10 +296,19 @@ public:
 			window.setFramerateLimit(framerate);
 		}
 	}
+	void TickRate(unsigned tickRate_)
+	{
+		tickRate = std::min(tickRate_, 1000u);
+		tickTime = (tickRate > 0 ? sf::microseconds(1000000 / tickRate) : sf::Time::Zero);
+		tickAccumulator = sf::Time::Zero;
+	}
 	void SmoothScreen(bool smooth_);
 	void StretchToFit(bool stretchToFit_);
 	void KeepAR(bool keepAR_);
 	void PauseOnFocusLoss(bool pause_) { pauseOnFocusLoss = pause_; }
+	void Occlusion(bool occlusion_) { occlusion = occlusion_; }
+	void OcclusionUpdate(bool occlusionUpdate_) { occlusionUpdate = occlusionUpdate_; }
+	void ParallelLoad(bool parallelLoad_) { parallelLoad = parallelLoad_; }
 
 	unsigned MusicVolume() const { return musicVolume; }
 	void MusicVolume(unsigned volume)
@@ -256,6 +341,11 @@ public:
 	ResourceManager& Resources() { return resourceManager; }
 	const ResourceManager& Resources() const { return resourceManager; }
 	EventManager& Events() { return eventManager; }
+	Profiler& getProfiler() { return profiler; }
+	TextBindingStats& getTextBindingStats() { return textBindingStats; }
+	JsonCache& getJsonCache() { return jsonCache; }
+	FileTemplateCache& getFileTemplates() { return fileTemplates; }
+	ParseTracer& getParseTracer() { return parseTracer; }
 
 	void setPath(const std::string& path_) { path = path_; }
 	void setTitle(const std::string& title_)
@@ -281,10 +371,13 @@ public:
 
 	void play();
 
-	const std::map<std::string, Variable>& getVariables() { return variables; }
+	// returns the id of a variable name (without %), adding it if it doesn't exist.
+	uint32_t getVariableId(const std::string& key) { return variables.getId(key); }
 
 	bool getVariableNoPercentage(const std::string& key, Variable& var) const;
 	bool getVariable(const std::string& key, Variable& var) const;
+	bool getVariable(uint32_t id, Variable& var) const { return variables.get(id, var); }
+	const Variable* getVariableValue(uint32_t id) const { return variables.getValue(id); }
 
 	template <class T, class U>
 	U getVarOrProp(const Variable& var, U defVal = U())
@@ -319,8 +412,10 @@ public:
 	std::string getVarOrPropString(const Variable& var) const;
 
 	void clearVariable(const std::string& key);
+	void clearVariable(uint32_t id) { variables.clear(id); }
 
 	void setVariable(const std::string& key, const Variable& value);
+	void setVariable(uint32_t id, const Variable& value) { variables.set(id, value); }
 
 	void saveVariables(const std::string& filePath, const std::vector<std::string>& varNames) const;
 
@@ -0,0 +1,566 @@
+#include "ConnectedRegions.h"
+#include <algorithm>
+#include "LevelMap.h"
+
+// the cells around a cell, in order around it
+static const int32_t ringDirections[8][2] =
+{
+	{ -1, -1 }, { 0, -1 }, { 1, -1 }, { 1, 0 },
+	{ 1, 1 }, { 0, 1 }, { -1, 1 }, { -1, 0 }
+};
+
+// the cells next to a cell, without the diagonals
+static const int32_t sideDirections[4][2] =
+{
+	{ 0, -1 }, { 1, 0 }, { 0, 1 }, { -1, 0 }
+};
+
+// regions that can be added by updates before the labels are compacted
+static const size_t maxUnusedRegions = 1024;
+
+uint32_t ConnectedRegions::find(uint32_t region)
+{
+	while (parents[region] != region)
+	{
+		parents[region] = parents[parents[region]];
+		region = parents[region];
+	}
+	return region;
+}
+
+uint32_t ConnectedRegions::join(uint32_t regionA, uint32_t regionB)
+{
+	regionA = find(regionA);
+	regionB = find(regionB);
+	if (regionA != regionB)
+	{
+		parents[std::max(regionA, regionB)] = std::min(regionA, regionB);
+	}
+	return std::min(regionA, regionB);
+}
+
+uint32_t ConnectedRegions::newRegion()
+{
+	auto region = (uint32_t)parents.size();
+	parents.push_back(region);
+	return region;
+}
+
+void ConnectedRegions::label(const LevelMap& map)
+{
+	width = map.Width();
+	height = map.Height();
+	labels.assign((size_t)width * (size_t)height, 0);
+	parents.clear();
+	parents.push_back(0);
+
+	for (uint32_t startIdx = 0; startIdx < labels.size(); startIdx++)
+	{
+		if (labels[startIdx] != 0 ||
+			map.isPassable(startIdx % width, startIdx / width) == false)
+		{
+			continue;
+		}
+		auto region = newRegion();
+		labels[startIdx] = region;
+		queue.clear();
+		queue.push_back(startIdx);
+
+		for (size_t i = 0; i < queue.size(); i++)
+		{
+			auto idx = queue[i];
+			auto x = (int32_t)(idx % width);
+			auto y = (int32_t)(idx / width);
+
+			auto canWalkLeft = map.isPassable(x - 1, y);
+			auto canWalkRight = map.isPassable(x + 1, y);
+			auto canWalkUp = map.isPassable(x, y - 1);
+			auto canWalkDown = map.isPassable(x, y + 1);
+
+			auto addCell = [&](bool canWalk, int32_t newX, int32_t newY)
+			{
+				if (canWalk == false)
+				{
+					return;
+				}
+				auto newIdx = (uint32_t)newX + (uint32_t)newY * width;
+				if (labels[newIdx] == 0)
+				{
+					labels[newIdx] = region;
+					queue.push_back(newIdx);
+				}
+			};
+
+			addCell(canWalkLeft, x - 1, y);
+			addCell(canWalkRight, x + 1, y);
+			addCell(canWalkUp, x, y - 1);
+			addCell(canWalkDown, x, y + 1);
+			addCell(canWalkLeft && canWalkUp && map.isPassable(x - 1, y - 1), x - 1, y - 1);
+			addCell(canWalkLeft && canWalkDown && map.isPassable(x - 1, y + 1), x - 1, y + 1);
+			addCell(canWalkRight && canWalkUp && map.isPassable(x + 1, y - 1), x + 1, y - 1);
+			addCell(canWalkRight && canWalkDown && map.isPassable(x + 1, y + 1), x + 1, y + 1);
+		}
+	}
+	numRegions = parents.size() - 1;
+	dirty = false;
+}
+
+void ConnectedRegions::compact()
+{
+	std::vector<uint32_t> newRegions(parents.size(), 0);
+	uint32_t nextRegion = 1;
+	for (auto& region : labels)
+	{
+		if (region == 0)
+		{
+			continue;
+		}
+		auto root = find(region);
+		if (newRegions[root] == 0)
+		{
+			newRegions[root] = nextRegion++;
+		}
+		region = newRegions[root];
+	}
+	parents.resize(nextRegion);
+	for (uint32_t i = 0; i < nextRegion; i++)
+	{
+		parents[i] = i;
+	}
+	numRegions = nextRegion - 1;
+}
+
+void ConnectedRegions::splitFrom(const LevelMap& map, int32_t x, int32_t y)
+{
+	// the sides are the passable cells next to the blocked one. Diagonal
+	// cells could only be walked to through them.
+	size_t numSides = 0;
+	if (visits.size() != labels.size())
+	{
+		visits.assign(labels.size(), 0);
+		visitStamp = 0;
+	}
+	visitStamp++;
+	if (visitStamp >= (1u << 30))
+	{
+		std::fill(visits.begin(), visits.end(), 0);
+		visitStamp = 1;
+	}
+	for (const auto& dir : sideDirections)
+	{
+		if (map.isPassable(x + dir[0], y + dir[1]) == true)
+		{
+			auto idx = (uint32_t)(x + dir[0]) + (uint32_t)(y + dir[1]) * width;
+			visits[idx] = (visitStamp << 2) | (uint32_t)numSides;
+			splitQueues[numSides].clear();
+			splitQueues[numSides].push_back(idx);
+			numSides++;
+		}
+	}
+	if (numSides <= 1)
+	{
+		return;
+	}
+
+	// sides whose fills met are in the same group
+	uint32_t sideGroups[4] = { 0, 1, 2, 3 };
+	auto findGroup = [&sideGroups](uint32_t side)
+	{
+		while (sideGroups[side] != side)
+		{
+			side = sideGroups[side];
+		}
+		return side;
+	};
+	size_t heads[4] = {};
+	size_t numVisited = numSides;
+	auto maxVisited = labels.size() / 2;
+
+	while (true)
+	{
+		// a group is open while one of its sides still has cells to visit.
+		// the fills stop when all the sides met or only one group is open.
+		bool isGroup[4] = {};
+		bool isOpen[4] = {};
+		size_t numGroups = 0;
+		size_t numOpen = 0;
+		for (uint32_t side = 0; side < numSides; side++)
+		{
+			auto group = findGroup(side);
+			if (isGroup[group] == false)
+			{
+				isGroup[group] = true;
+				numGroups++;
+			}
+			if (heads[side] < splitQueues[side].size() && isOpen[group] == false)
+			{
+				isOpen[group] = true;
+				numOpen++;
+			}
+		}
+		if (numGroups == 1)
+		{
+			return;
+		}
+		if (numOpen <= 1)
+		{
+			break;
+		}
+		if (numVisited > maxVisited)
+		{
+			// about as slow as labelling the whole map
+			dirty = true;
+			return;
+		}
+
+		// one cell of each side at a time, so the smaller sides end first
+		for (uint32_t side = 0; side < numSides; side++)
+		{
+			auto& sideQueue = splitQueues[side];
+			if (heads[side] >= sideQueue.size())
+			{
+				continue;
+			}
+			auto idx = sideQueue[heads[side]++];
+			auto cellX = (int32_t)(idx % width);
+			auto cellY = (int32_t)(idx / width);
+
+			auto canWalkLeft = map.isPassable(cellX - 1, cellY);
+			auto canWalkRight = map.isPassable(cellX + 1, cellY);
+			auto canWalkUp = map.isPassable(cellX, cellY - 1);
+			auto canWalkDown = map.isPassable(cellX, cellY + 1);
+
+			auto addCell = [&](bool canWalk, int32_t newX, int32_t newY)
+			{
+				if (canWalk == false)
+				{
+					return;
+				}
+				auto newIdx = (uint32_t)newX + (uint32_t)newY * width;
+				auto visit = visits[newIdx];
+				if ((visit >> 2) != visitStamp)
+				{
+					visits[newIdx] = (visitStamp << 2) | side;
+					sideQueue.push_back(newIdx);
+					numVisited++;
+					return;
+				}
+				auto groupA = findGroup(visit & 3);
+				auto groupB = findGroup(side);
+				if (groupA != groupB)
+				{
+					sideGroups[std::max(groupA, groupB)] = std::min(groupA, groupB);
+				}
+			};
+
+			addCell(canWalkLeft, cellX - 1, cellY);
+			addCell(canWalkRight, cellX + 1, cellY);
+			addCell(canWalkUp, cellX, cellY - 1);
+			addCell(canWalkDown, cellX, cellY + 1);
+			addCell(canWalkLeft && canWalkUp && map.isPassable(cellX - 1, cellY - 1), cellX - 1, cellY - 1);
+			addCell(canWalkLeft && canWalkDown && map.isPassable(cellX - 1, cellY + 1), cellX - 1, cellY + 1);
+			addCell(canWalkRight && canWalkUp && map.isPassable(cellX + 1, cellY - 1), cellX + 1, cellY - 1);
+			addCell(canWalkRight && canWalkDown && map.isPassable(cellX + 1, cellY + 1), cellX + 1, cellY + 1);
+		}
+	}
+
+	// the open group keeps the region. If every group ended, the biggest
+	// one keeps it. The other groups were fully visited and get new regions.
+	size_t groupSizes[4] = {};
+	uint32_t keepGroup = 4;
+	for (uint32_t side = 0; side < numSides; side++)
+	{
+		auto group = findGroup(side);
+		groupSizes[group] += splitQueues[side].size();
+		if (heads[side] < splitQueues[side].size())
+		{
+			keepGroup = group;
+		}
+	}
+	if (keepGroup == 4)
+	{
+		keepGroup = 0;
+		for (uint32_t group = 1; group < numSides; group++)
+		{
+			if (groupSizes[group] > groupSizes[keepGroup])
+			{
+				keepGroup = group;
+			}
+		}
+	}
+	for (uint32_t group = 0; group < numSides; group++)
+	{
+		if (group == keepGroup || groupSizes[group] == 0)
+		{
+			continue;
+		}
+		auto region = newRegion();
+		for (uint32_t side = 0; side < numSides; side++)
+		{
+			if (findGroup(side) != group)
+			{
+				continue;
+			}
+			for (auto idx : splitQueues[side])
+			{
+				labels[idx] = region;
+			}
+		}
+	}
+}
+
+bool ConnectedRegions::isLocallyConnected(const LevelMap& map, int32_t x, int32_t y) const
+{
+	// without the centre cell, cells around it can only be walked between
+	// through the ones next to them in the ring (diagonal moves between
+	// the side cells need the centre or the corner in between), so they're
+	// connected if the passable cells form a single run around the ring.
+	bool passable[8];
+	size_t numPassable = 0;
+	for (size_t i = 0; i < 8; i++)
+	{
+		passable[i] = map.isPassable(x + ringDirections[i][0], y + ringDirections[i][1]);
+		if (passable[i] == true)
+		{
+			numPassable++;
+		}
+	}
+	if (numPassable == 8)
+	{
+		return true;
+	}
+	size_t numRuns = 0;
+	size_t firstRun = 0;
+	for (size_t i = 0; i < 8; i++)
+	{
+		if (passable[i] == true && passable[(i + 7) % 8] == false)
+		{
+			if (numRuns == 0)
+			{
+				firstRun = i;
+			}
+			numRuns++;
+		}
+	}
+	if (numRuns <= 1)
+	{
+		return true;
+	}
+
+	// the runs are usually joined a few cells away (walking around a
+	// player that stands next to a wall), so search a small window first.
+	static const int32_t windowRadius = localSearchRadius;
+	static const int32_t windowSize = windowRadius * 2 + 1;
+	bool visited[windowSize * windowSize] = {};
+	int32_t localQueue[windowSize * windowSize];
+	size_t queueSize = 0;
+
+	auto isPassable = [&](int32_t localX, int32_t localY)
+	{
+		return localX >= 0 && localX < windowSize &&
+			localY >= 0 && localY < windowSize &&
+			map.isPassable(x + localX - windowRadius, y + localY - windowRadius);
+	};
+
+	auto startIdx = (windowRadius + ringDirections[firstRun][0]) +
+		(windowRadius + ringDirections[firstRun][1]) * windowSize;
+	visited[startIdx] = true;
+	localQueue[queueSize++] = startIdx;
+	for (size_t i = 0; i < queueSize; i++)
+	{
+		auto localX = localQueue[i] % windowSize;
+		auto localY = localQueue[i] / windowSize;
+
+		auto canWalkLeft = isPassable(localX - 1, localY);
+		auto canWalkRight = isPassable(localX + 1, localY);
+		auto canWalkUp = isPassable(localX, localY - 1);
+		auto canWalkDown = isPassable(localX, localY + 1);
+
+		auto addCell = [&](bool canWalk, int32_t newX, int32_t newY)
+		{
+			auto newIdx = newX + newY * windowSize;
+			if (canWalk == true && visited[newIdx] == false)
+			{
+				visited[newIdx] = true;
+				localQueue[queueSize++] = newIdx;
+			}
+		};
+
+		addCell(canWalkLeft, localX - 1, localY);
+		addCell(canWalkRight, localX + 1, localY);
+		addCell(canWalkUp, localX, localY - 1);
+		addCell(canWalkDown, localX, localY + 1);
+		addCell(canWalkLeft && canWalkUp && isPassable(localX - 1, localY - 1), localX - 1, localY - 1);
+		addCell(canWalkLeft && canWalkDown && isPassable(localX - 1, localY + 1), localX - 1, localY + 1);
+		addCell(canWalkRight && canWalkUp && isPassable(localX + 1, localY - 1), localX + 1, localY - 1);
+		addCell(canWalkRight && canWalkDown && isPassable(localX + 1, localY + 1), localX + 1, localY + 1);
+	}
+	for (size_t i = 0; i < 8; i++)
+	{
+		if (passable[i] == true &&
+			visited[(windowRadius + ringDirections[i][0]) +
+				(windowRadius + ringDirections[i][1]) * windowSize] == false)
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+void ConnectedRegions::invalidate(const LevelMap& map, const MapCoord& cell)
+{
+	if (dirty == true)
+	{
+		return;
+	}
+	if (cell.x >= width || cell.y >= height ||
+		width != map.Width() || height != map.Height())
+	{
+		dirty = true;
+		return;
+	}
+	auto x = (int32_t)cell.x;
+	auto y = (int32_t)cell.y;
+	auto idx = (size_t)cell.x + (size_t)cell.y * width;
+
+	if (map.isPassable(x, y) == false)
+	{
+		labels[idx] = 0;
+		if (isLocallyConnected(map, x, y) == false)
+		{
+			splitFrom(map, x, y);
+		}
+	}
+	else
+	{
+		joinFrom(map, x, y);
+	}
+	if (dirty == false &&
+		parents.size() > numRegions * 2 + maxUnusedRegions)
+	{
+		compact();
+	}
+}
+
+void ConnectedRegions::joinFrom(const LevelMap& map, int32_t x, int32_t y)
+{
+	auto idx = (size_t)x + (size_t)y * width;
+
+	// a new passable cell joins the regions it can be walked to from
+	auto canWalkLeft = map.isPassable(x - 1, y);
+	auto canWalkRight = map.isPassable(x + 1, y);
+	auto canWalkUp = map.isPassable(x, y - 1);
+	auto canWalkDown = map.isPassable(x, y + 1);
+
+	uint32_t region = 0;
+	auto joinCell = [&](bool canWalk, int32_t newX, int32_t newY)
+	{
+		if (canWalk == false)
+		{
+			return;
+		}
+		auto cellRegion = labels[(size_t)newX + (size_t)newY * width];
+		if (cellRegion == 0)
+		{
+			return;
+		}
+		region = (region == 0 ? find(cellRegion) : join(region, cellRegion));
+	};
+
+	joinCell(canWalkLeft, x - 1, y);
+	joinCell(canWalkRight, x + 1, y);
+	joinCell(canWalkUp, x, y - 1);
+	joinCell(canWalkDown, x, y + 1);
+	joinCell(canWalkLeft && canWalkUp && map.isPassable(x - 1, y - 1), x - 1, y - 1);
+	joinCell(canWalkLeft && canWalkDown && map.isPassable(x - 1, y + 1), x - 1, y + 1);
+	joinCell(canWalkRight && canWalkUp && map.isPassable(x + 1, y - 1), x + 1, y - 1);
+	joinCell(canWalkRight && canWalkDown && map.isPassable(x + 1, y + 1), x + 1, y + 1);
+
+	labels[idx] = (region == 0 ? newRegion() : region);
+}
+
+void ConnectedRegions::update(const LevelMap& map)
+{
+	if (dirty == true ||
+		width != map.Width() ||
+		height != map.Height())
+	{
+		label(map);
+	}
+}
+
+uint32_t ConnectedRegions::getRegion(const LevelMap& map, const MapCoord& cell)
+{
+	update(map);
+	if (cell.x >= width || cell.y >= height)
+	{
+		return 0;
+	}
+	auto region = labels[(size_t)cell.x + (size_t)cell.y * width];
+	return (region == 0 ? 0 : find(region));
+}
+
+size_t ConnectedRegions::getRegionsAround(const LevelMap& map, const MapCoord& start, uint32_t* regions)
+{
+	update(map);
+	if (start.x >= width || start.y >= height)
+	{
+		return 0;
+	}
+	size_t numRegions = 0;
+	auto addRegion = [&](uint32_t region)
+	{
+		if (region == 0)
+		{
+			return;
+		}
+		region = find(region);
+		if (std::find(regions, regions + numRegions, region) == regions + numRegions)
+		{
+			regions[numRegions++] = region;
+		}
+	};
+
+	auto x = (int32_t)start.x;
+	auto y = (int32_t)start.y;
+	addRegion(labels[(size_t)x + (size_t)y * width]);
+
+	auto canWalkLeft = map.isPassable(x - 1, y);
+	auto canWalkRight = map.isPassable(x + 1, y);
+	auto canWalkUp = map.isPassable(x, y - 1);
+	auto canWalkDown = map.isPassable(x, y + 1);
+
+	auto addCell = [&](bool canWalk, int32_t newX, int32_t newY)
+	{
+		if (canWalk == true)
+		{
+			addRegion(labels[(size_t)newX + (size_t)newY * width]);
+		}
+	};
+
+	addCell(canWalkLeft, x - 1, y);
+	addCell(canWalkRight, x + 1, y);
+	addCell(canWalkUp, x, y - 1);
+	addCell(canWalkDown, x, y + 1);
+	addCell(canWalkLeft && canWalkUp && map.isPassable(x - 1, y - 1), x - 1, y - 1);
+	addCell(canWalkLeft && canWalkDown && map.isPassable(x - 1, y + 1), x - 1, y + 1);
+	addCell(canWalkRight && canWalkUp && map.isPassable(x + 1, y - 1), x + 1, y - 1);
+	addCell(canWalkRight && canWalkDown && map.isPassable(x + 1, y + 1), x + 1, y + 1);
+	return numRegions;
+}
+
+bool ConnectedRegions::isReachable(const LevelMap& map, const MapCoord& start, const MapCoord& goal)
+{
+	if (start == goal)
+	{
+		return true;
+	}
+	auto goalRegion = getRegion(map, goal);
+	if (goalRegion == 0)
+	{
+		return false;
+	}
+	uint32_t regions[9];
+	auto numRegions = getRegionsAround(map, start, regions);
+	return std::find(regions, regions + numRegions, goalRegion) != regions + numRegions;
+}
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include "MapCoord.h"
+#include <vector>
+
+class LevelMap;
+
+// Labels the passable cells of the map by the region of cells that can be
+// walked to from them (same moves as GridPathFinder), so two cells can be
+// checked for a path in O(1). Cells that become passable join the regions
+// around them. Cells that become blocked flood fill from each side of the
+// cell, all at once, until the sides meet again or only one is left, so a
+// split only relabels the cells that were cut off (the smaller sides).
+class ConnectedRegions
+{
+private:
+	// blocked cells that split the cells around them in separate groups
+	// search this far for a way around before relabelling the map
+	static const int32_t localSearchRadius = 3;
+
+	Coord width{ 0 };
+	Coord height{ 0 };
+
+	// region of each cell (0 for blocked cells). Regions joined after the
+	// map was labelled point to the region they were merged into.
+	std::vector<uint32_t> labels;
+	std::vector<uint32_t> parents;
+	std::vector<uint32_t> queue;
+	bool dirty{ true };
+
+	// regions left after the last labelling or compaction
+	size_t numRegions{ 0 };
+
+	// flood fills of splitFrom, one per side of the blocked cell. visits
+	// has the side (low 2 bits) and visitStamp of the last fill of each cell.
+	std::vector<uint32_t> splitQueues[4];
+	std::vector<uint32_t> visits;
+	uint32_t visitStamp{ 0 };
+
+	uint32_t find(uint32_t region);
+	uint32_t join(uint32_t regionA, uint32_t regionB);
+	uint32_t newRegion();
+
+	void label(const LevelMap& map);
+
+	// renumbers the labels to the regions they were merged into, so the
+	// regions that aren't used any more are dropped from parents.
+	void compact();
+
+	// gives new regions to the cells cut off by the blocked cell x, y.
+	void splitFrom(const LevelMap& map, int32_t x, int32_t y);
+
+	// joins the regions around the passable cell x, y.
+	void joinFrom(const LevelMap& map, int32_t x, int32_t y);
+
+	// true if the passable cells around cell are still connected to each
+	// other without going through cell (false if it isn't known).
+	bool isLocallyConnected(const LevelMap& map, int32_t x, int32_t y) const;
+
+public:
+	// marks everything for a relabel (the map's size or tiles changed).
+	void invalidate() { dirty = true; }
+
+	// the passability of a single cell changed.
+	void invalidate(const LevelMap& map, const MapCoord& cell);
+
+	// labels the map, if needed.
+	void update(const LevelMap& map);
+
+	// region of a passable cell (0 if blocked or outside the map).
+	uint32_t getRegion(const LevelMap& map, const MapCoord& cell);
+
+	// gets the regions that can be walked to from start (start's own
+	// region and the regions of the cells next to it, for when start is
+	// taken by the walker). Returns the number of regions (up to 9).
+	size_t getRegionsAround(const LevelMap& map, const MapCoord& start, uint32_t* regions);
+
+	// true if there's a path from start (which can be taken) to goal.
+	bool isReachable(const LevelMap& map, const MapCoord& start, const MapCoord& goal);
+};
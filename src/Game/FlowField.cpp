@@ -0,0 +1,137 @@
+#include "FlowField.h"
+#include <algorithm>
+#include "LevelMap.h"
+
+static const int32_t directions[8][2] =
+{
+	{ -1, 0 }, { 1, 0 }, { 0, -1 }, { 0, 1 },
+	{ -1, -1 }, { -1, 1 }, { 1, -1 }, { 1, 1 }
+};
+
+void FlowField::compute(const LevelMap& map, const MapCoord& goal_)
+{
+	width = map.Width();
+	height = map.Height();
+	goal = goal_;
+	distances.assign((size_t)width * (size_t)height, (uint16_t)unreachable);
+	if (goal.x >= width || goal.y >= height)
+	{
+		return;
+	}
+
+	// the goal can be a tile with an object on it (the walker's target),
+	// every other cell must be passable. Moves follow the same rules as
+	// GridPathFinder, which makes them the same in both directions.
+	auto isPassable = [&](int32_t x, int32_t y)
+	{
+		return (x == goal.x && y == goal.y) || map.isPassableIgnoreObject(x, y);
+	};
+
+	std::vector<uint32_t> queue;
+	queue.reserve(distances.size());
+	auto goalIdx = (uint32_t)goal.x + (uint32_t)goal.y * width;
+	distances[goalIdx] = 0;
+	queue.push_back(goalIdx);
+
+	for (size_t i = 0; i < queue.size(); i++)
+	{
+		auto idx = queue[i];
+		auto x = (int32_t)(idx % width);
+		auto y = (int32_t)(idx / width);
+		auto distance = (uint16_t)std::min(distances[idx] + 1, unreachable - 1);
+		for (const auto& dir : directions)
+		{
+			auto newX = x + dir[0];
+			auto newY = y + dir[1];
+			if (isPassable(newX, newY) == false)
+			{
+				continue;
+			}
+			if (dir[0] != 0 && dir[1] != 0 &&
+				(isPassable(newX, y) == false || isPassable(x, newY) == false))
+			{
+				continue;
+			}
+			auto newIdx = (uint32_t)newX + (uint32_t)newY * width;
+			if (distances[newIdx] == unreachable)
+			{
+				distances[newIdx] = distance;
+				queue.push_back(newIdx);
+			}
+		}
+	}
+}
+
+bool FlowField::getNextStep(const LevelMap& map, const MapCoord& cell, MapCoord& next) const
+{
+	auto bestDistance = getDistance(cell);
+	if (bestDistance == unreachable || bestDistance == 0)
+	{
+		return false;
+	}
+
+	// other walkers block cells, so both the field and the current
+	// passability are checked (the goal itself can be taken).
+	auto isPassable = [&](int32_t x, int32_t y)
+	{
+		return (x == goal.x && y == goal.y) || map.isPassable(x, y);
+	};
+
+	auto x = (int32_t)cell.x;
+	auto y = (int32_t)cell.y;
+	auto found = false;
+	for (const auto& dir : directions)
+	{
+		auto newX = x + dir[0];
+		auto newY = y + dir[1];
+		if (newX < 0 || newX >= width ||
+			newY < 0 || newY >= height)
+		{
+			continue;
+		}
+		auto distance = distances[newX + newY * width];
+		if (distance >= bestDistance ||
+			isPassable(newX, newY) == false)
+		{
+			continue;
+		}
+		if (dir[0] != 0 && dir[1] != 0 &&
+			(isPassable(newX, y) == false || isPassable(x, newY) == false))
+		{
+			continue;
+		}
+		bestDistance = distance;
+		next = MapCoord((Coord)newX, (Coord)newY);
+		found = true;
+	}
+	return found;
+}
+
+std::shared_ptr<const FlowField> FlowFieldCache::get(const LevelMap& map, const MapCoord& goal)
+{
+	useCount++;
+	auto key = (uint32_t)goal.x + (uint32_t)goal.y * map.Width();
+	auto it = fields.find(key);
+	if (it != fields.end())
+	{
+		it->second.lastUsed = useCount;
+		return it->second.field;
+	}
+	if (fields.size() >= maxFlowFields)
+	{
+		auto oldest = fields.begin();
+		for (auto it2 = fields.begin(); it2 != fields.end(); ++it2)
+		{
+			if (it2->second.lastUsed < oldest->second.lastUsed)
+			{
+				oldest = it2;
+			}
+		}
+		fields.erase(oldest);
+	}
+	auto& entry = fields[key];
+	entry.field = std::make_shared<FlowField>();
+	entry.field->compute(map, goal);
+	entry.lastUsed = useCount;
+	return entry.field;
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include "MapCoord.h"
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+class LevelMap;
+
+// Distances to a goal cell for every cell of the map (breadth first search
+// from the goal). Only the tiles' passability is used, so the field stays
+// valid while objects move around and any number of walkers can share it.
+class FlowField
+{
+private:
+	Coord width{ 0 };
+	Coord height{ 0 };
+	MapCoord goal;
+	std::vector<uint16_t> distances;
+
+public:
+	static const uint16_t unreachable = 0xFFFF;
+
+	void compute(const LevelMap& map, const MapCoord& goal_);
+
+	const MapCoord& Goal() const { return goal; }
+
+	uint16_t getDistance(const MapCoord& cell) const
+	{
+		if (cell.x >= width || cell.y >= height)
+		{
+			return unreachable;
+		}
+		return distances[cell.x + cell.y * width];
+	}
+
+	bool isReachable(const MapCoord& cell) const { return getDistance(cell) != unreachable; }
+
+	// gets the next cell from cell towards the goal. Cells taken by other
+	// objects are walked around if there's another cell that is closer
+	// to the goal. Returns false if there's no such cell right now, which
+	// is also the case behind objects that don't move (use a path search).
+	bool getNextStep(const LevelMap& map, const MapCoord& cell, MapCoord& next) const;
+};
+
+// Flow fields by goal, shared by all the walkers heading to the same cell.
+class FlowFieldCache
+{
+private:
+	// least recently used fields are dropped past this
+	static const size_t maxFlowFields = 16;
+
+	struct Entry
+	{
+		std::shared_ptr<FlowField> field;
+		uint32_t lastUsed{ 0 };
+	};
+
+	std::unordered_map<uint32_t, Entry> fields;
+	uint32_t useCount{ 0 };
+
+public:
+	// gets the field for goal, computing it if it isn't cached.
+	std::shared_ptr<const FlowField> get(const LevelMap& map, const MapCoord& goal);
+
+	// drops all fields (the map's size or tiles changed).
+	void invalidate() { fields.clear(); }
+
+	size_t size() const { return fields.size(); }
+};
@@ -26,6 +26,14 @@ enum class InventoryPosition : size_t
 typedef int32_t LevelObjValue;
 typedef std::pair<uint16_t, LevelObjValue> LevelObjProperty;
 
+enum class PathFinderMode : size_t
+{
+	AStar,
+	JPS,
+	Hierarchical,
+	Size
+};
+
 enum class PlayerDirection : size_t
 {
 	Front,
@@ -81,4 +89,12 @@ enum class PlayerStatus : size_t
 	Size
 };
 
+enum class PlayerWalkMode : size_t
+{
+	Path,
+	Incremental,
+	FlowField,
+	Size
+};
+
 PlayerDirection getPlayerDirection(const MapCoord& currPos, const MapCoord& newPos);
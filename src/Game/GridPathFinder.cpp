@@ -0,0 +1,405 @@
+#include "GridPathFinder.h"
+#include <algorithm>
+#include <cstdlib>
+#include "LevelMap.h"
+
+static uint32_t distanceEstimate(int32_t x1, int32_t y1, int32_t x2, int32_t y2)
+{
+	return (uint32_t)std::max(std::abs(x1 - x2), std::abs(y1 - y2));
+}
+
+void GridPathFinder::beginSearch(const LevelMap& map)
+{
+	auto numCells = (size_t)map.Width() * (size_t)map.Height();
+	if (generations.size() != numCells)
+	{
+		generations.assign(numCells, 0);
+		gCost.resize(numCells);
+		fCost.resize(numCells);
+		parents.resize(numCells);
+		openList.resize(numCells);
+		generation = 0;
+	}
+	else
+	{
+		openList.clear();
+	}
+	width = map.Width();
+	height = map.Height();
+	generation++;
+	if (generation == 0)
+	{
+		std::fill(generations.begin(), generations.end(), 0);
+		generation = 1;
+	}
+	expandedNodes = 0;
+}
+
+void GridPathFinder::open(size_t idx, int32_t parentIdx, uint32_t g, uint32_t h)
+{
+	generations[idx] = generation;
+	gCost[idx] = g;
+	fCost[idx] = g + h;
+	parents[idx] = parentIdx;
+	// ties on f are broken in favour of the node closest to the goal
+	openList.push((uint32_t)idx, ((uint64_t)fCost[idx] << 32) | h);
+}
+
+static int32_t sign(int32_t val)
+{
+	return (val > 0) - (val < 0);
+}
+
+void GridPathFinder::buildPath(size_t goalIdx, std::vector<MapCoord>& path) const
+{
+	// parents can be more than one cell away (jump points), but always
+	// along a straight or diagonal line.
+	auto idx = (int32_t)goalIdx;
+	while (true)
+	{
+		auto x = idx % (int32_t)width;
+		auto y = idx / (int32_t)width;
+		auto parentIdx = parents[idx];
+		if (parentIdx < 0)
+		{
+			path.push_back(MapCoord((Coord)x, (Coord)y));
+			break;
+		}
+		auto parentX = parentIdx % (int32_t)width;
+		auto parentY = parentIdx / (int32_t)width;
+		auto dx = sign(parentX - x);
+		auto dy = sign(parentY - y);
+		while (x != parentX || y != parentY)
+		{
+			path.push_back(MapCoord((Coord)x, (Coord)y));
+			x += dx;
+			y += dy;
+		}
+		idx = parentIdx;
+	}
+}
+
+bool GridPathFinder::findPath(const LevelMap& map, const MapCoord& a, const MapCoord& b,
+	std::vector<MapCoord>& path, size_t maxNodes)
+{
+	if (a.x >= map.Width() || a.y >= map.Height() ||
+		b.x >= map.Width() || b.y >= map.Height())
+	{
+		return false;
+	}
+
+	beginSearch(map);
+
+	auto startIdx = (size_t)a.x + (size_t)a.y * width;
+	auto goalIdx = (size_t)b.x + (size_t)b.y * width;
+
+	open(startIdx, -1, 0, distanceEstimate(a.x, a.y, b.x, b.y));
+
+	while (openList.empty() == false)
+	{
+		auto idx = openList.pop();
+		if (idx == goalIdx)
+		{
+			buildPath(goalIdx, path);
+			return true;
+		}
+		if (maxNodes > 0 && expandedNodes >= maxNodes)
+		{
+			break;
+		}
+		expandedNodes++;
+
+		auto x = (int32_t)(idx % width);
+		auto y = (int32_t)(idx / width);
+		auto g = gCost[idx] + 1;
+
+		auto canWalkLeft = map.isPassable(x - 1, y);
+		auto canWalkRight = map.isPassable(x + 1, y);
+		auto canWalkUp = map.isPassable(x, y - 1);
+		auto canWalkDown = map.isPassable(x, y + 1);
+
+		auto addSuccessor = [&](bool canWalk, int32_t newX, int32_t newY)
+		{
+			if (canWalk == false)
+			{
+				return;
+			}
+			auto newIdx = (size_t)newX + (size_t)newY * width;
+			if (visited(newIdx) == true)
+			{
+				// closed nodes never improve with a consistent heuristic
+				if (openList.contains((uint32_t)newIdx) == false ||
+					g >= gCost[newIdx])
+				{
+					return;
+				}
+			}
+			open(newIdx, (int32_t)idx, g, distanceEstimate(newX, newY, b.x, b.y));
+		};
+
+		addSuccessor(canWalkLeft, x - 1, y);
+		addSuccessor(canWalkRight, x + 1, y);
+		addSuccessor(canWalkUp, x, y - 1);
+		addSuccessor(canWalkDown, x, y + 1);
+		addSuccessor(canWalkLeft && canWalkUp && map.isPassable(x - 1, y - 1), x - 1, y - 1);
+		addSuccessor(canWalkLeft && canWalkDown && map.isPassable(x - 1, y + 1), x - 1, y + 1);
+		addSuccessor(canWalkRight && canWalkUp && map.isPassable(x + 1, y - 1), x + 1, y - 1);
+		addSuccessor(canWalkRight && canWalkDown && map.isPassable(x + 1, y + 1), x + 1, y + 1);
+	}
+	return false;
+}
+
+bool GridPathFinder::jumpStraight(const LevelMap& map, int32_t& x, int32_t& y,
+	int32_t dx, int32_t dy, const MapCoord& goal) const
+{
+	while (true)
+	{
+		if (map.isPassable(x, y) == false)
+		{
+			return false;
+		}
+		if (x == goal.x && y == goal.y)
+		{
+			return true;
+		}
+		// forced neighbours: a side cell that can't be reached diagonally
+		// from the previous cell, because the cell behind it is blocked.
+		if (dx != 0)
+		{
+			if ((map.isPassable(x, y - 1) == true && map.isPassable(x - dx, y - 1) == false) ||
+				(map.isPassable(x, y + 1) == true && map.isPassable(x - dx, y + 1) == false))
+			{
+				return true;
+			}
+		}
+		else
+		{
+			if ((map.isPassable(x - 1, y) == true && map.isPassable(x - 1, y - dy) == false) ||
+				(map.isPassable(x + 1, y) == true && map.isPassable(x + 1, y - dy) == false))
+			{
+				return true;
+			}
+		}
+		x += dx;
+		y += dy;
+	}
+}
+
+bool GridPathFinder::jump(const LevelMap& map, int32_t& x, int32_t& y,
+	int32_t dx, int32_t dy, const MapCoord& goal) const
+{
+	if (dx == 0 || dy == 0)
+	{
+		return jumpStraight(map, x, y, dx, dy, goal);
+	}
+	while (true)
+	{
+		if (map.isPassable(x, y) == false)
+		{
+			return false;
+		}
+		if (x == goal.x && y == goal.y)
+		{
+			return true;
+		}
+		auto x2 = x + dx;
+		auto y2 = y;
+		if (jumpStraight(map, x2, y2, dx, 0, goal) == true)
+		{
+			return true;
+		}
+		x2 = x;
+		y2 = y + dy;
+		if (jumpStraight(map, x2, y2, 0, dy, goal) == true)
+		{
+			return true;
+		}
+		// no corner cutting
+		if (map.isPassable(x + dx, y) == false ||
+			map.isPassable(x, y + dy) == false)
+		{
+			return false;
+		}
+		x += dx;
+		y += dy;
+	}
+}
+
+bool GridPathFinder::findPathJPS(const LevelMap& map, const MapCoord& a, const MapCoord& b,
+	std::vector<MapCoord>& path, size_t maxNodes)
+{
+	if (a.x >= map.Width() || a.y >= map.Height() ||
+		b.x >= map.Width() || b.y >= map.Height())
+	{
+		return false;
+	}
+
+	beginSearch(map);
+
+	auto startIdx = (size_t)a.x + (size_t)a.y * width;
+	auto goalIdx = (size_t)b.x + (size_t)b.y * width;
+
+	open(startIdx, -1, 0, distanceEstimate(a.x, a.y, b.x, b.y));
+
+	std::pair<int32_t, int32_t> directions[8];
+
+	while (openList.empty() == false)
+	{
+		auto idx = openList.pop();
+		if (idx == goalIdx)
+		{
+			buildPath(goalIdx, path);
+			return true;
+		}
+		if (maxNodes > 0 && expandedNodes >= maxNodes)
+		{
+			break;
+		}
+		expandedNodes++;
+
+		auto x = (int32_t)(idx % width);
+		auto y = (int32_t)(idx / width);
+		size_t numDirections = 0;
+
+		auto parentIdx = parents[idx];
+		if (parentIdx < 0)
+		{
+			auto canWalkLeft = map.isPassable(x - 1, y);
+			auto canWalkRight = map.isPassable(x + 1, y);
+			auto canWalkUp = map.isPassable(x, y - 1);
+			auto canWalkDown = map.isPassable(x, y + 1);
+			if (canWalkLeft == true)
+			{
+				directions[numDirections++] = std::make_pair(-1, 0);
+			}
+			if (canWalkRight == true)
+			{
+				directions[numDirections++] = std::make_pair(1, 0);
+			}
+			if (canWalkUp == true)
+			{
+				directions[numDirections++] = std::make_pair(0, -1);
+			}
+			if (canWalkDown == true)
+			{
+				directions[numDirections++] = std::make_pair(0, 1);
+			}
+			if (canWalkLeft == true && canWalkUp == true)
+			{
+				directions[numDirections++] = std::make_pair(-1, -1);
+			}
+			if (canWalkLeft == true && canWalkDown == true)
+			{
+				directions[numDirections++] = std::make_pair(-1, 1);
+			}
+			if (canWalkRight == true && canWalkUp == true)
+			{
+				directions[numDirections++] = std::make_pair(1, -1);
+			}
+			if (canWalkRight == true && canWalkDown == true)
+			{
+				directions[numDirections++] = std::make_pair(1, 1);
+			}
+		}
+		else
+		{
+			// prune the neighbours that are reached at least as cheaply
+			// without going through this node.
+			auto dx = sign(x - parentIdx % (int32_t)width);
+			auto dy = sign(y - parentIdx / (int32_t)width);
+			if (dx != 0 && dy != 0)
+			{
+				auto canWalkX = map.isPassable(x + dx, y);
+				auto canWalkY = map.isPassable(x, y + dy);
+				if (canWalkX == true)
+				{
+					directions[numDirections++] = std::make_pair(dx, 0);
+				}
+				if (canWalkY == true)
+				{
+					directions[numDirections++] = std::make_pair(0, dy);
+				}
+				if (canWalkX == true && canWalkY == true)
+				{
+					directions[numDirections++] = std::make_pair(dx, dy);
+				}
+			}
+			else if (dx != 0)
+			{
+				auto canWalkNext = map.isPassable(x + dx, y);
+				auto canWalkUp = map.isPassable(x, y - 1);
+				auto canWalkDown = map.isPassable(x, y + 1);
+				if (canWalkNext == true)
+				{
+					directions[numDirections++] = std::make_pair(dx, 0);
+					if (canWalkUp == true)
+					{
+						directions[numDirections++] = std::make_pair(dx, -1);
+					}
+					if (canWalkDown == true)
+					{
+						directions[numDirections++] = std::make_pair(dx, 1);
+					}
+				}
+				if (canWalkUp == true)
+				{
+					directions[numDirections++] = std::make_pair(0, -1);
+				}
+				if (canWalkDown == true)
+				{
+					directions[numDirections++] = std::make_pair(0, 1);
+				}
+			}
+			else
+			{
+				auto canWalkNext = map.isPassable(x, y + dy);
+				auto canWalkLeft = map.isPassable(x - 1, y);
+				auto canWalkRight = map.isPassable(x + 1, y);
+				if (canWalkNext == true)
+				{
+					directions[numDirections++] = std::make_pair(0, dy);
+					if (canWalkLeft == true)
+					{
+						directions[numDirections++] = std::make_pair(-1, dy);
+					}
+					if (canWalkRight == true)
+					{
+						directions[numDirections++] = std::make_pair(1, dy);
+					}
+				}
+				if (canWalkLeft == true)
+				{
+					directions[numDirections++] = std::make_pair(-1, 0);
+				}
+				if (canWalkRight == true)
+				{
+					directions[numDirections++] = std::make_pair(1, 0);
+				}
+			}
+		}
+
+		for (size_t i = 0; i < numDirections; i++)
+		{
+			auto dx = directions[i].first;
+			auto dy = directions[i].second;
+			auto jumpX = x + dx;
+			auto jumpY = y + dy;
+			if (jump(map, jumpX, jumpY, dx, dy, b) == false)
+			{
+				continue;
+			}
+			auto jumpIdx = (size_t)jumpX + (size_t)jumpY * width;
+			auto g = gCost[idx] + distanceEstimate(x, y, jumpX, jumpY);
+			if (visited(jumpIdx) == true)
+			{
+				if (openList.contains((uint32_t)jumpIdx) == false ||
+					g >= gCost[jumpIdx])
+				{
+					continue;
+				}
+			}
+			open(jumpIdx, (int32_t)idx, g, distanceEstimate(jumpX, jumpY, b.x, b.y));
+		}
+	}
+	return false;
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include "GameProperties.h"
+#include "IndexedHeap.h"
+#include "MapCoord.h"
+#include <vector>
+
+class LevelMap;
+
+// A* and Jump Point Search over the LevelMap grid. All moves (including
+// diagonals) cost 1 and diagonals are only allowed if both orthogonal
+// neighbours are passable. Node data is kept in flat per-cell arrays that are
+// stamped with the current search generation, so nothing needs to be cleared
+// between searches.
+class GridPathFinder
+{
+private:
+	std::vector<uint32_t> generations;
+	std::vector<uint32_t> gCost;
+	std::vector<uint32_t> fCost;
+	std::vector<int32_t> parents;
+	IndexedHeap<uint64_t> openList;
+	uint32_t generation{ 0 };
+	Coord width{ 0 };
+	Coord height{ 0 };
+
+	size_t expandedNodes{ 0 };
+
+	void beginSearch(const LevelMap& map);
+
+	bool visited(size_t idx) const { return generations[idx] == generation; }
+
+	void open(size_t idx, int32_t parentIdx, uint32_t g, uint32_t h);
+
+	void buildPath(size_t goalIdx, std::vector<MapCoord>& path) const;
+
+	bool jumpStraight(const LevelMap& map, int32_t& x, int32_t& y,
+		int32_t dx, int32_t dy, const MapCoord& goal) const;
+	bool jump(const LevelMap& map, int32_t& x, int32_t& y,
+		int32_t dx, int32_t dy, const MapCoord& goal) const;
+
+public:
+	// returns the path in reverse order (goal first, start last).
+	// maxNodes limits the number of expanded nodes (0 = no limit).
+	bool findPath(const LevelMap& map, const MapCoord& a, const MapCoord& b,
+		std::vector<MapCoord>& path, size_t maxNodes = 0);
+
+	// same contract as findPath. Returns paths of the same length as findPath,
+	// but only expands jump points, so open areas are crossed in a few steps.
+	bool findPathJPS(const LevelMap& map, const MapCoord& a, const MapCoord& b,
+		std::vector<MapCoord>& path, size_t maxNodes = 0);
+
+	bool findPath(const LevelMap& map, const MapCoord& a, const MapCoord& b,
+		PathFinderMode mode, std::vector<MapCoord>& path, size_t maxNodes = 0)
+	{
+		if (mode == PathFinderMode::JPS)
+		{
+			return findPathJPS(map, a, b, path, maxNodes);
+		}
+		return findPath(map, a, b, path, maxNodes);
+	}
+
+	// number of nodes expanded by the last search.
+	size_t ExpandedNodes() const { return expandedNodes; }
+};
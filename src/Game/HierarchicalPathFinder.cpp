@@ -0,0 +1,607 @@
+#include "HierarchicalPathFinder.h"
+#include <algorithm>
+#include <cstdlib>
+#include "LevelMap.h"
+
+static uint32_t distanceEstimate(int32_t x1, int32_t y1, int32_t x2, int32_t y2)
+{
+	return (uint32_t)std::max(std::abs(x1 - x2), std::abs(y1 - y2));
+}
+
+void HierarchicalPathFinder::init(const LevelMap& map)
+{
+	width = map.Width();
+	height = map.Height();
+	clustersX = (width + clusterSize - 1) / clusterSize;
+	clustersY = (height + clusterSize - 1) / clusterSize;
+
+	clusters.clear();
+	borders.clear();
+	nodes.clear();
+	freeNodes.clear();
+	dirtyClusters.clear();
+	dirtyBorders.clear();
+
+	auto numCells = (size_t)width * (size_t)height;
+	cellNodes.assign(numCells, -1);
+
+	for (Coord j = 0; j < clustersY; j++)
+	{
+		for (Coord i = 0; i < clustersX; i++)
+		{
+			Cluster cluster;
+			cluster.x = i * clusterSize;
+			cluster.y = j * clusterSize;
+			cluster.width = std::min((Coord)(width - cluster.x), (Coord)clusterSize);
+			cluster.height = std::min((Coord)(height - cluster.y), (Coord)clusterSize);
+			clusters.push_back(cluster);
+		}
+	}
+	// borders with the cluster to the right first, then the ones below
+	for (Coord j = 0; j < clustersY; j++)
+	{
+		for (Coord i = 0; i + 1 < clustersX; i++)
+		{
+			Border border;
+			border.clusterA = i + j * clustersX;
+			border.clusterB = border.clusterA + 1;
+			border.horizontal = true;
+			borders.push_back(border);
+		}
+	}
+	for (Coord j = 0; j + 1 < clustersY; j++)
+	{
+		for (Coord i = 0; i < clustersX; i++)
+		{
+			Border border;
+			border.clusterA = i + j * clustersX;
+			border.clusterB = border.clusterA + clustersX;
+			border.horizontal = false;
+			borders.push_back(border);
+		}
+	}
+	for (size_t i = 0; i < borders.size(); i++)
+	{
+		setBorderDirty((uint32_t)i);
+	}
+	for (size_t i = 0; i < clusters.size(); i++)
+	{
+		setClusterDirty((uint32_t)i);
+	}
+}
+
+void HierarchicalPathFinder::setClusterDirty(uint32_t clusterIdx)
+{
+	if (clusters[clusterIdx].dirty == false)
+	{
+		clusters[clusterIdx].dirty = true;
+		dirtyClusters.push_back(clusterIdx);
+	}
+}
+
+void HierarchicalPathFinder::setBorderDirty(uint32_t borderIdx)
+{
+	if (borders[borderIdx].dirty == false)
+	{
+		borders[borderIdx].dirty = true;
+		dirtyBorders.push_back(borderIdx);
+	}
+}
+
+void HierarchicalPathFinder::invalidate(const MapCoord& cell)
+{
+	if (cell.x >= width || cell.y >= height)
+	{
+		return;
+	}
+	auto clusterX = cell.x / clusterSize;
+	auto clusterY = cell.y / clusterSize;
+	auto localX = cell.x % clusterSize;
+	auto localY = cell.y % clusterSize;
+	auto numHorizontalBorders = (uint32_t)(clustersX - 1) * clustersY;
+
+	setClusterDirty(getClusterIndex(cell.x, cell.y));
+
+	if (localX == 0 && clusterX > 0)
+	{
+		setBorderDirty((clusterX - 1) + clusterY * (clustersX - 1));
+	}
+	if (localX == clusterSize - 1 && clusterX + 1 < clustersX)
+	{
+		setBorderDirty(clusterX + clusterY * (clustersX - 1));
+	}
+	if (localY == 0 && clusterY > 0)
+	{
+		setBorderDirty(numHorizontalBorders + clusterX + (clusterY - 1) * clustersX);
+	}
+	if (localY == clusterSize - 1 && clusterY + 1 < clustersY)
+	{
+		setBorderDirty(numHorizontalBorders + clusterX + clusterY * clustersX);
+	}
+}
+
+uint32_t HierarchicalPathFinder::acquireNode(uint32_t cell, uint32_t clusterIdx)
+{
+	auto nodeIdx = cellNodes[cell];
+	if (nodeIdx >= 0)
+	{
+		nodes[nodeIdx].refCount++;
+		return (uint32_t)nodeIdx;
+	}
+	if (freeNodes.empty() == false)
+	{
+		nodeIdx = (int32_t)freeNodes.back();
+		freeNodes.pop_back();
+	}
+	else
+	{
+		nodeIdx = (int32_t)nodes.size();
+		nodes.push_back(Node());
+	}
+	auto& node = nodes[nodeIdx];
+	node.cell = cell;
+	node.cluster = clusterIdx;
+	node.refCount = 1;
+	node.links.clear();
+	cellNodes[cell] = nodeIdx;
+	clusters[clusterIdx].nodes.push_back((uint32_t)nodeIdx);
+	setClusterDirty(clusterIdx);
+	return (uint32_t)nodeIdx;
+}
+
+void HierarchicalPathFinder::releaseNode(uint32_t nodeIdx)
+{
+	auto& node = nodes[nodeIdx];
+	node.refCount--;
+	if (node.refCount > 0)
+	{
+		return;
+	}
+	auto& clusterNodes = clusters[node.cluster].nodes;
+	clusterNodes.erase(std::find(clusterNodes.begin(), clusterNodes.end(), nodeIdx));
+	cellNodes[node.cell] = -1;
+	node.links.clear();
+	freeNodes.push_back(nodeIdx);
+	setClusterDirty(node.cluster);
+}
+
+void HierarchicalPathFinder::updateBorder(const LevelMap& map, uint32_t borderIdx)
+{
+	auto& border = borders[borderIdx];
+	border.dirty = false;
+
+	for (const auto& transition : border.transitions)
+	{
+		auto& linksA = nodes[transition.first].links;
+		linksA.erase(std::find(linksA.begin(), linksA.end(), transition.second));
+		auto& linksB = nodes[transition.second].links;
+		linksB.erase(std::find(linksB.begin(), linksB.end(), transition.first));
+		releaseNode(transition.first);
+		releaseNode(transition.second);
+	}
+	border.transitions.clear();
+
+	const auto& clusterA = clusters[border.clusterA];
+	Coord length;
+	int32_t x, y, dx, dy;
+	if (border.horizontal == true)
+	{
+		length = clusterA.height;
+		x = clusterA.x + clusterA.width - 1;
+		y = clusterA.y;
+		dx = 0;
+		dy = 1;
+	}
+	else
+	{
+		length = clusterA.width;
+		x = clusterA.x;
+		y = clusterA.y + clusterA.height - 1;
+		dx = 1;
+		dy = 0;
+	}
+	// the cell on the other side is one step along the normal of the border
+	auto otherX = dy;
+	auto otherY = dx;
+
+	auto addTransition = [&](int32_t i)
+	{
+		auto cellX = x + i * dx;
+		auto cellY = y + i * dy;
+		auto cellA = (uint32_t)cellX + (uint32_t)cellY * width;
+		auto cellB = (uint32_t)(cellX + otherX) + (uint32_t)(cellY + otherY) * width;
+		auto nodeA = acquireNode(cellA, border.clusterA);
+		auto nodeB = acquireNode(cellB, border.clusterB);
+		nodes[nodeA].links.push_back(nodeB);
+		nodes[nodeB].links.push_back(nodeA);
+		border.transitions.push_back(std::make_pair(nodeA, nodeB));
+	};
+
+	int32_t runStart = -1;
+	for (int32_t i = 0; i <= (int32_t)length; i++)
+	{
+		auto passable = i < (int32_t)length &&
+			map.isPassable(x + i * dx, y + i * dy) == true &&
+			map.isPassable(x + i * dx + otherX, y + i * dy + otherY) == true;
+		if (passable == true)
+		{
+			if (runStart < 0)
+			{
+				runStart = i;
+			}
+			continue;
+		}
+		if (runStart < 0)
+		{
+			continue;
+		}
+		auto runEnd = i - 1;
+		if (runEnd - runStart + 1 >= (int32_t)maxSingleEntranceLength)
+		{
+			addTransition(runStart);
+			addTransition(runEnd);
+		}
+		else
+		{
+			addTransition(runStart + (runEnd - runStart) / 2);
+		}
+		runStart = -1;
+	}
+}
+
+void HierarchicalPathFinder::updateCluster(const LevelMap& map, uint32_t clusterIdx)
+{
+	auto& cluster = clusters[clusterIdx];
+	cluster.dirty = false;
+
+	auto numNodes = cluster.nodes.size();
+	cluster.distances.assign(numNodes * numNodes, (uint16_t)unreachable);
+
+	for (size_t i = 0; i < numNodes; i++)
+	{
+		nodes[cluster.nodes[i]].clusterIdx = (uint32_t)i;
+		cluster.distances[i * numNodes + i] = 0;
+	}
+	if (numNodes < 2)
+	{
+		return;
+	}
+	loadRect(map, cluster.x, cluster.y,
+		(Coord)(cluster.x + cluster.width - 1), (Coord)(cluster.y + cluster.height - 1));
+
+	// paths are symmetric, so each search only needs to fill in the nodes after it
+	for (size_t i = 0; i + 1 < numNodes; i++)
+	{
+		auto cell = nodes[cluster.nodes[i]].cell;
+		searchRect(MapCoord((Coord)(cell % width), (Coord)(cell / width)));
+
+		for (size_t j = i + 1; j < numNodes; j++)
+		{
+			auto distance = rectDistance(nodes[cluster.nodes[j]].cell);
+			cluster.distances[i * numNodes + j] = distance;
+			cluster.distances[j * numNodes + i] = distance;
+		}
+	}
+}
+
+void HierarchicalPathFinder::loadRect(const LevelMap& map,
+	Coord minX, Coord minY, Coord maxX, Coord maxY)
+{
+	rectX = minX;
+	rectY = minY;
+	rectWidth = maxX - minX + 1;
+	rectHeight = maxY - minY + 1;
+
+	auto stride = (size_t)rectWidth + 2;
+	rectPassable.assign(stride * ((size_t)rectHeight + 2), 0);
+	rectDistances.resize(rectPassable.size());
+	for (Coord j = 0; j < rectHeight; j++)
+	{
+		auto row = rectPassable.data() + (j + 1) * stride + 1;
+		for (Coord i = 0; i < rectWidth; i++)
+		{
+			row[i] = map.isPassable(rectX + i, rectY + j) == true ? 1 : 0;
+		}
+	}
+}
+
+void HierarchicalPathFinder::searchRect(const MapCoord& start)
+{
+	auto stride = (int32_t)rectWidth + 2;
+	const int32_t offsets[] = { -1, 1, -stride, stride };
+	std::fill(rectDistances.begin(), rectDistances.end(), (uint16_t)unreachable);
+
+	// the start cell is searched from even if it isn't passable (occupied by a player)
+	auto startIdx = (uint32_t)(start.x - rectX + 1) + (uint32_t)(start.y - rectY + 1) * stride;
+	rectDistances[startIdx] = 0;
+	rectQueue.clear();
+	rectQueue.push_back(startIdx);
+
+	auto passable = rectPassable.data();
+	for (size_t queueIdx = 0; queueIdx < rectQueue.size(); queueIdx++)
+	{
+		auto idx = rectQueue[queueIdx];
+		auto distance = (uint16_t)(rectDistances[idx] + 1);
+
+		auto addCell = [&](uint32_t newIdx)
+		{
+			if (rectDistances[newIdx] == unreachable)
+			{
+				rectDistances[newIdx] = distance;
+				rectQueue.push_back(newIdx);
+			}
+		};
+
+		bool canWalk[4];
+		for (size_t i = 0; i < 4; i++)
+		{
+			canWalk[i] = passable[idx + offsets[i]] != 0;
+			if (canWalk[i] == true)
+			{
+				addCell(idx + offsets[i]);
+			}
+		}
+		// diagonals, only if both orthogonal neighbours are passable
+		for (size_t i = 0; i < 2; i++)
+		{
+			for (size_t j = 2; j < 4; j++)
+			{
+				auto newIdx = idx + offsets[i] + offsets[j];
+				if (canWalk[i] == true && canWalk[j] == true && passable[newIdx] != 0)
+				{
+					addCell(newIdx);
+				}
+			}
+		}
+	}
+}
+
+uint16_t HierarchicalPathFinder::rectDistance(uint32_t cell) const
+{
+	auto x = (int32_t)(cell % width) - rectX;
+	auto y = (int32_t)(cell / width) - rectY;
+	if (x < 0 || x >= rectWidth || y < 0 || y >= rectHeight)
+	{
+		return unreachable;
+	}
+	return rectDistances[(x + 1) + (y + 1) * ((int32_t)rectWidth + 2)];
+}
+
+void HierarchicalPathFinder::searchClustersAround(const LevelMap& map, const MapCoord& start,
+	Coord& minClusterX, Coord& minClusterY, Coord& maxClusterX, Coord& maxClusterY)
+{
+	minClusterX = (Coord)(std::max((int32_t)start.x - 1, 0) / clusterSize);
+	minClusterY = (Coord)(std::max((int32_t)start.y - 1, 0) / clusterSize);
+	maxClusterX = (Coord)(std::min((int32_t)start.x + 1, (int32_t)width - 1) / clusterSize);
+	maxClusterY = (Coord)(std::min((int32_t)start.y + 1, (int32_t)height - 1) / clusterSize);
+
+	const auto& minCluster = clusters[minClusterX + minClusterY * clustersX];
+	const auto& maxCluster = clusters[maxClusterX + maxClusterY * clustersX];
+	loadRect(map, minCluster.x, minCluster.y,
+		(Coord)(maxCluster.x + maxCluster.width - 1), (Coord)(maxCluster.y + maxCluster.height - 1));
+	searchRect(start);
+}
+
+void HierarchicalPathFinder::update(const LevelMap& map)
+{
+	if (width != map.Width() || height != map.Height())
+	{
+		init(map);
+	}
+	// borders first, they add and remove the entrance nodes of their clusters
+	for (auto borderIdx : dirtyBorders)
+	{
+		updateBorder(map, borderIdx);
+	}
+	dirtyBorders.clear();
+	for (auto clusterIdx : dirtyClusters)
+	{
+		updateCluster(map, clusterIdx);
+	}
+	dirtyClusters.clear();
+}
+
+bool HierarchicalPathFinder::findPath(const LevelMap& map, const MapCoord& a, const MapCoord& b,
+	std::vector<MapCoord>& path, size_t maxSegments)
+{
+	expandedNodes = 0;
+	update(map);
+
+	if (a.x >= width || a.y >= height ||
+		b.x >= width || b.y >= height)
+	{
+		return false;
+	}
+	if (a == b)
+	{
+		path.push_back(a);
+		return true;
+	}
+
+	auto numNodes = (uint32_t)nodes.size();
+	auto goalIdx = numNodes;
+	auto startIdx = numNodes + 1;
+	if (openList.capacity() != numNodes + 1)
+	{
+		nodeGenerations.assign(numNodes + 1, 0);
+		nodeCost.resize(numNodes + 1);
+		nodeParents.resize(numNodes + 1);
+		goalGenerations.assign(numNodes, 0);
+		goalDistances.resize(numNodes);
+		openList.resize(numNodes + 1);
+		nodeGeneration = 0;
+	}
+	else
+	{
+		openList.clear();
+	}
+	nodeGeneration++;
+	if (nodeGeneration == 0)
+	{
+		std::fill(nodeGenerations.begin(), nodeGenerations.end(), 0);
+		std::fill(goalGenerations.begin(), goalGenerations.end(), 0);
+		nodeGeneration = 1;
+	}
+
+	Coord minClusterX, minClusterY, maxClusterX, maxClusterY;
+
+	// the goal connects to the entrances it can reach in its own clusters
+	searchClustersAround(map, b, minClusterX, minClusterY, maxClusterX, maxClusterY);
+	for (auto j = minClusterY; j <= maxClusterY; j++)
+	{
+		for (auto i = minClusterX; i <= maxClusterX; i++)
+		{
+			for (auto nodeIdx : clusters[i + j * clustersX].nodes)
+			{
+				auto distance = rectDistance(nodes[nodeIdx].cell);
+				if (distance != unreachable)
+				{
+					goalGenerations[nodeIdx] = nodeGeneration;
+					goalDistances[nodeIdx] = distance;
+				}
+			}
+		}
+	}
+
+	searchClustersAround(map, a, minClusterX, minClusterY, maxClusterX, maxClusterY);
+
+	// the goal is close enough to search the grid directly
+	if (rectDistance((uint32_t)b.x + (uint32_t)b.y * width) != unreachable)
+	{
+		auto found = gridPathFinder.findPath(map, a, b, path);
+		expandedNodes = gridPathFinder.ExpandedNodes();
+		return found;
+	}
+
+	auto openNode = [&](uint32_t nodeIdx, uint32_t parentIdx, uint32_t g)
+	{
+		if (nodeGenerations[nodeIdx] == nodeGeneration)
+		{
+			// closed nodes never improve with a consistent heuristic
+			if (openList.contains(nodeIdx) == false ||
+				g >= nodeCost[nodeIdx])
+			{
+				return;
+			}
+		}
+		uint32_t h = 0;
+		if (nodeIdx != goalIdx)
+		{
+			auto cell = nodes[nodeIdx].cell;
+			h = distanceEstimate(cell % width, cell / width, b.x, b.y);
+		}
+		nodeGenerations[nodeIdx] = nodeGeneration;
+		nodeCost[nodeIdx] = g;
+		nodeParents[nodeIdx] = parentIdx;
+		openList.push(nodeIdx, ((uint64_t)(g + h) << 32) | h);
+	};
+
+	for (auto j = minClusterY; j <= maxClusterY; j++)
+	{
+		for (auto i = minClusterX; i <= maxClusterX; i++)
+		{
+			for (auto nodeIdx : clusters[i + j * clustersX].nodes)
+			{
+				auto distance = rectDistance(nodes[nodeIdx].cell);
+				if (distance != unreachable)
+				{
+					openNode(nodeIdx, startIdx, distance);
+				}
+			}
+		}
+	}
+
+	while (openList.empty() == false)
+	{
+		auto nodeIdx = openList.pop();
+		if (nodeIdx == goalIdx)
+		{
+			// entrance cells from the goal back to (but without) the start
+			path.push_back(b);
+			auto parentIdx = nodeParents[goalIdx];
+			while (parentIdx != startIdx)
+			{
+				auto cell = nodes[parentIdx].cell;
+				MapCoord coord((Coord)(cell % width), (Coord)(cell / width));
+				if (coord != path.back() && coord != a)
+				{
+					path.push_back(coord);
+				}
+				parentIdx = nodeParents[parentIdx];
+			}
+			if (refinePath(map, a, path, maxSegments) == false)
+			{
+				return false;
+			}
+			path.push_back(a);
+			return true;
+		}
+		expandedNodes++;
+
+		auto g = nodeCost[nodeIdx];
+		if (goalGenerations[nodeIdx] == nodeGeneration)
+		{
+			openNode(goalIdx, nodeIdx, g + goalDistances[nodeIdx]);
+		}
+
+		const auto& node = nodes[nodeIdx];
+		const auto& cluster = clusters[node.cluster];
+		auto numClusterNodes = cluster.nodes.size();
+		auto distances = cluster.distances.data() + node.clusterIdx * numClusterNodes;
+		for (size_t i = 0; i < numClusterNodes; i++)
+		{
+			if (distances[i] != unreachable && i != node.clusterIdx)
+			{
+				openNode(cluster.nodes[i], nodeIdx, g + distances[i]);
+			}
+		}
+		for (auto linkIdx : node.links)
+		{
+			openNode(linkIdx, nodeIdx, g + 1);
+		}
+	}
+	return false;
+}
+
+bool HierarchicalPathFinder::refinePath(const LevelMap& map, const MapCoord& a,
+	std::vector<MapCoord>& path, size_t maxSegments)
+{
+	forwardPath.clear();
+	auto from = a;
+	size_t numSegments = 0;
+	while (path.empty() == false)
+	{
+		auto to = path.back();
+		auto distance = distanceEstimate(from.x, from.y, to.x, to.y);
+		if (distance > 1 &&
+			maxSegments > 0 && numSegments >= maxSegments)
+		{
+			break;
+		}
+		// diagonal steps can't cut corners
+		if (distance > 1 ||
+			(distance == 1 && from.x != to.x && from.y != to.y &&
+			(map.isPassable(to.x, from.y) == false || map.isPassable(from.x, to.y) == false)))
+		{
+			segment.clear();
+			auto found = gridPathFinder.findPath(map, from, to, segment);
+			expandedNodes += gridPathFinder.ExpandedNodes();
+			if (found == false)
+			{
+				path.insert(path.end(), forwardPath.rbegin(), forwardPath.rend());
+				return false;
+			}
+			// segment goes from "to" back to "from"
+			forwardPath.insert(forwardPath.end(), segment.rbegin() + 1, segment.rend());
+			numSegments++;
+		}
+		else if (distance == 1)
+		{
+			forwardPath.push_back(to);
+		}
+		path.pop_back();
+		from = to;
+	}
+	path.insert(path.end(), forwardPath.rbegin(), forwardPath.rend());
+	return true;
+}
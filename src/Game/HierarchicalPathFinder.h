@@ -0,0 +1,145 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include "GridPathFinder.h"
+#include "IndexedHeap.h"
+#include "MapCoord.h"
+#include <vector>
+
+class LevelMap;
+
+// HPA* over the LevelMap grid. The map is divided into square clusters and
+// each run of passable cells along a cluster border gets one or two entrance
+// nodes. Distances between the entrances of a cluster are cached, so a search
+// only expands entrance nodes. Passability changes mark the affected cluster
+// (and borders) dirty and only those are rebuilt before the next search.
+class HierarchicalPathFinder
+{
+private:
+	static const Coord clusterSize = 16;
+	// border runs at least this long get an entrance at each end
+	static const Coord maxSingleEntranceLength = 6;
+	static const uint16_t unreachable = 0xFFFF;
+
+	struct Node
+	{
+		uint32_t cell{ 0 };
+		uint32_t cluster{ 0 };
+		uint32_t clusterIdx{ 0 };
+		uint32_t refCount{ 0 };
+		// entrance nodes on the other side of a cluster border (cost 1)
+		std::vector<uint32_t> links;
+	};
+
+	struct Cluster
+	{
+		Coord x{ 0 };
+		Coord y{ 0 };
+		Coord width{ 0 };
+		Coord height{ 0 };
+		std::vector<uint32_t> nodes;
+		// nodes.size() * nodes.size() path lengths inside the cluster
+		std::vector<uint16_t> distances;
+		bool dirty{ false };
+	};
+
+	struct Border
+	{
+		uint32_t clusterA{ 0 };
+		uint32_t clusterB{ 0 };
+		bool horizontal{ false }; // clusterB is to the right (true) or below clusterA
+		std::vector<std::pair<uint32_t, uint32_t>> transitions;
+		bool dirty{ false };
+	};
+
+	Coord width{ 0 };
+	Coord height{ 0 };
+	Coord clustersX{ 0 };
+	Coord clustersY{ 0 };
+
+	std::vector<Cluster> clusters;
+	std::vector<Border> borders;
+	std::vector<Node> nodes;
+	std::vector<uint32_t> freeNodes;
+	std::vector<int32_t> cellNodes;
+	std::vector<uint32_t> dirtyClusters;
+	std::vector<uint32_t> dirtyBorders;
+
+	// breadth first search over a rectangle of cells. Passability is copied
+	// into rectPassable with a blocked border around it, so the search needs
+	// no bounds checks.
+	Coord rectX{ 0 };
+	Coord rectY{ 0 };
+	Coord rectWidth{ 0 };
+	Coord rectHeight{ 0 };
+	std::vector<uint8_t> rectPassable;
+	std::vector<uint16_t> rectDistances;
+	std::vector<uint32_t> rectQueue;
+
+	// abstract search
+	std::vector<uint32_t> nodeGenerations;
+	std::vector<uint32_t> nodeCost;
+	std::vector<uint32_t> nodeParents;
+	std::vector<uint32_t> goalGenerations;
+	std::vector<uint16_t> goalDistances;
+	IndexedHeap<uint64_t> openList;
+	uint32_t nodeGeneration{ 0 };
+
+	GridPathFinder gridPathFinder;
+	std::vector<MapCoord> segment;
+	std::vector<MapCoord> forwardPath;
+
+	size_t expandedNodes{ 0 };
+
+	uint32_t getClusterIndex(Coord x, Coord y) const
+	{
+		return (uint32_t)(x / clusterSize) + (uint32_t)(y / clusterSize) * clustersX;
+	}
+
+	void init(const LevelMap& map);
+
+	void setClusterDirty(uint32_t clusterIdx);
+	void setBorderDirty(uint32_t borderIdx);
+
+	uint32_t acquireNode(uint32_t cell, uint32_t clusterIdx);
+	void releaseNode(uint32_t nodeIdx);
+
+	void updateBorder(const LevelMap& map, uint32_t borderIdx);
+	void updateCluster(const LevelMap& map, uint32_t clusterIdx);
+
+	void loadRect(const LevelMap& map, Coord minX, Coord minY, Coord maxX, Coord maxY);
+	void searchRect(const MapCoord& start);
+	uint16_t rectDistance(uint32_t cell) const;
+
+	// searches the clusters around start (start's cluster and the ones next to
+	// it, if start is on a cluster border) and returns their range.
+	void searchClustersAround(const LevelMap& map, const MapCoord& start,
+		Coord& minClusterX, Coord& minClusterY, Coord& maxClusterX, Coord& maxClusterY);
+
+public:
+	// marks everything for a rebuild (the map's size or tiles changed).
+	void invalidate() { width = height = 0; }
+
+	// the passability of a single cell changed.
+	void invalidate(const MapCoord& cell);
+
+	// builds the cluster graph or updates the dirty parts of it.
+	void update(const LevelMap& map);
+
+	// returns the path in reverse order (goal first, start last).
+	// Only the first maxSegments abstract segments are refined into cells,
+	// the rest of the path is made of entrance cells that can be refined
+	// later with refinePath (maxSegments = 0 refines the whole path).
+	bool findPath(const LevelMap& map, const MapCoord& a, const MapCoord& b,
+		std::vector<MapCoord>& path, size_t maxSegments = 0);
+
+	// refines the next maxSegments non adjacent cells at the back of a
+	// path returned by findPath, starting from a. Afterwards, the back of
+	// the path is walkable up to the first cell that isn't adjacent.
+	bool refinePath(const LevelMap& map, const MapCoord& a,
+		std::vector<MapCoord>& path, size_t maxSegments = 0);
+
+	// number of abstract and grid nodes expanded by the last search.
+	size_t ExpandedNodes() const { return expandedNodes; }
+};
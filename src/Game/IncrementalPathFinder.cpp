@@ -0,0 +1,247 @@
+#include "IncrementalPathFinder.h"
+#include <algorithm>
+#include <cstdlib>
+#include "LevelMap.h"
+#include <limits>
+
+static uint32_t distanceEstimate(int32_t x1, int32_t y1, int32_t x2, int32_t y2)
+{
+	return (uint32_t)std::max(std::abs(x1 - x2), std::abs(y1 - y2));
+}
+
+static const int32_t directions[8][2] =
+{
+	{ -1, 0 }, { 1, 0 }, { 0, -1 }, { 0, 1 },
+	{ -1, -1 }, { -1, 1 }, { 1, -1 }, { 1, 1 }
+};
+
+bool IncrementalPathFinder::isPassable(int32_t x, int32_t y) const
+{
+	if (x == goal.x && y == goal.y)
+	{
+		return true;
+	}
+	return map->isPassable(x, y);
+}
+
+bool IncrementalPathFinder::canWalk(int32_t x, int32_t y, int32_t dx, int32_t dy) const
+{
+	if (isPassable(x + dx, y + dy) == false)
+	{
+		return false;
+	}
+	if (dx != 0 && dy != 0)
+	{
+		return isPassable(x + dx, y) == true && isPassable(x, y + dy) == true;
+	}
+	return true;
+}
+
+uint64_t IncrementalPathFinder::calculateKey(size_t idx) const
+{
+	auto cost = std::min(gCost[idx], rhsCost[idx]);
+	if (cost == infinity)
+	{
+		return std::numeric_limits<uint64_t>::max();
+	}
+	auto h = distanceEstimate((int32_t)(idx % width), (int32_t)(idx / width), start.x, start.y);
+	return ((uint64_t)(cost + h + km) << 32) | cost;
+}
+
+void IncrementalPathFinder::updateVertex(size_t idx)
+{
+	auto x = (int32_t)(idx % width);
+	auto y = (int32_t)(idx / width);
+	if (x == goal.x && y == goal.y)
+	{
+		rhsCost[idx] = 0;
+	}
+	else
+	{
+		auto rhs = infinity;
+		for (const auto& dir : directions)
+		{
+			if (canWalk(x, y, dir[0], dir[1]) == true)
+			{
+				auto g = gCost[(x + dir[0]) + (y + dir[1]) * width];
+				if (g != infinity)
+				{
+					rhs = std::min(rhs, g + 1);
+				}
+			}
+		}
+		rhsCost[idx] = rhs;
+	}
+	if (gCost[idx] != rhsCost[idx])
+	{
+		openList.push((uint32_t)idx, calculateKey(idx));
+	}
+	else
+	{
+		openList.remove((uint32_t)idx);
+	}
+}
+
+void IncrementalPathFinder::updateNeighbours(int32_t x, int32_t y)
+{
+	for (const auto& dir : directions)
+	{
+		auto newX = x + dir[0];
+		auto newY = y + dir[1];
+		if (newX >= 0 && newX < width &&
+			newY >= 0 && newY < height)
+		{
+			updateVertex(newX + newY * width);
+		}
+	}
+}
+
+void IncrementalPathFinder::updateCell(const MapCoord& cell)
+{
+	if (cell.x >= width || cell.y >= height)
+	{
+		return;
+	}
+	// the cell's passability changes the cost of moving into it and the
+	// cost of diagonal moves around it, which are all moves of its neighbours.
+	updateVertex(cell.x + cell.y * width);
+	updateNeighbours(cell.x, cell.y);
+}
+
+void IncrementalPathFinder::computeShortestPath()
+{
+	auto startIdx = (size_t)start.x + (size_t)start.y * width;
+	while (openList.empty() == false)
+	{
+		auto oldKey = openList.topKey();
+		if (oldKey >= calculateKey(startIdx) &&
+			rhsCost[startIdx] == gCost[startIdx])
+		{
+			break;
+		}
+		auto idx = openList.top();
+		auto x = (int32_t)(idx % width);
+		auto y = (int32_t)(idx / width);
+		expandedNodes++;
+
+		auto newKey = calculateKey(idx);
+		if (oldKey < newKey)
+		{
+			openList.push(idx, newKey);
+		}
+		else if (gCost[idx] > rhsCost[idx])
+		{
+			gCost[idx] = rhsCost[idx];
+			openList.remove(idx);
+			updateNeighbours(x, y);
+		}
+		else
+		{
+			gCost[idx] = infinity;
+			updateVertex(idx);
+			updateNeighbours(x, y);
+		}
+	}
+}
+
+void IncrementalPathFinder::reset(const LevelMap& map_, const MapCoord& a, const MapCoord& b)
+{
+	map = &map_;
+	width = map_.Width();
+	height = map_.Height();
+	start = a;
+	goal = b;
+	km = 0;
+	passableChangeCount = map_.PassableChangeCount();
+
+	auto numCells = (size_t)width * (size_t)height;
+	gCost.assign(numCells, (uint32_t)infinity);
+	rhsCost.assign(numCells, (uint32_t)infinity);
+	openList.resize(numCells);
+
+	updateVertex((size_t)goal.x + (size_t)goal.y * width);
+}
+
+bool IncrementalPathFinder::findPath(const LevelMap& map_, const MapCoord& a, const MapCoord& b,
+	std::vector<MapCoord>& path)
+{
+	expandedNodes = 0;
+	if (a.x >= map_.Width() || a.y >= map_.Height() ||
+		b.x >= map_.Width() || b.y >= map_.Height())
+	{
+		return false;
+	}
+
+	passableChanges.clear();
+	if (map != &map_ ||
+		width != map_.Width() ||
+		height != map_.Height() ||
+		map_.getPassableChanges(passableChangeCount, passableChanges) == false ||
+		distanceEstimate(goal.x, goal.y, b.x, b.y) > maxGoalMoveDistance)
+	{
+		reset(map_, a, b);
+	}
+	else
+	{
+		// keys already in the list were computed from the old start and
+		// are now too high by at most the distance walked.
+		km += distanceEstimate(start.x, start.y, a.x, a.y);
+		start = a;
+		passableChangeCount = map_.PassableChangeCount();
+		for (const auto& cell : passableChanges)
+		{
+			updateCell(cell);
+		}
+		// moving the goal is the same as changing which cell has a cost of 0
+		if (goal != b)
+		{
+			auto oldGoal = goal;
+			goal = b;
+			updateCell(oldGoal);
+			updateCell(goal);
+		}
+	}
+
+	computeShortestPath();
+
+	auto x = (int32_t)a.x;
+	auto y = (int32_t)a.y;
+	if (gCost[x + y * width] == infinity)
+	{
+		return false;
+	}
+
+	// follow the cheapest neighbours from the start
+	auto pathStart = path.size();
+	path.push_back(a);
+	while (x != goal.x || y != goal.y)
+	{
+		auto bestCost = infinity;
+		int32_t bestX = 0;
+		int32_t bestY = 0;
+		for (const auto& dir : directions)
+		{
+			if (canWalk(x, y, dir[0], dir[1]) == true)
+			{
+				auto g = gCost[(x + dir[0]) + (y + dir[1]) * width];
+				if (g < bestCost)
+				{
+					bestCost = g;
+					bestX = x + dir[0];
+					bestY = y + dir[1];
+				}
+			}
+		}
+		if (bestCost == infinity ||
+			path.size() - pathStart > (size_t)width * (size_t)height)
+		{
+			path.resize(pathStart);
+			return false;
+		}
+		x = bestX;
+		y = bestY;
+		path.push_back(MapCoord((Coord)x, (Coord)y));
+	}
+	std::reverse(path.begin() + pathStart, path.end());
+	return true;
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include "IndexedHeap.h"
+#include "MapCoord.h"
+#include <vector>
+
+class LevelMap;
+
+// D* Lite over the LevelMap grid, for a single walker. The search runs from
+// the goal to the walker, so when the walker moves, cells change passability
+// or the goal moves a few cells, only the affected part of the previous
+// search is repaired. Moves follow the same rules as GridPathFinder. The goal
+// cell itself can be occupied (it's the cell the walker interacts with).
+class IncrementalPathFinder
+{
+private:
+	static const uint32_t infinity = 0xFFFFFFFF;
+	// goal moves further than this start a new search
+	static const uint32_t maxGoalMoveDistance = 8;
+
+	std::vector<uint32_t> gCost;
+	std::vector<uint32_t> rhsCost;
+	IndexedHeap<uint64_t> openList;
+
+	const LevelMap* map{ nullptr };
+	Coord width{ 0 };
+	Coord height{ 0 };
+	MapCoord start;
+	MapCoord goal;
+	uint32_t km{ 0 };
+	uint32_t passableChangeCount{ 0 };
+	std::vector<MapCoord> passableChanges;
+
+	size_t expandedNodes{ 0 };
+
+	bool isPassable(int32_t x, int32_t y) const;
+	bool canWalk(int32_t x, int32_t y, int32_t dx, int32_t dy) const;
+
+	uint64_t calculateKey(size_t idx) const;
+	void updateVertex(size_t idx);
+	void updateNeighbours(int32_t x, int32_t y);
+	void updateCell(const MapCoord& cell);
+	void computeShortestPath();
+
+	void reset(const LevelMap& map_, const MapCoord& a, const MapCoord& b);
+
+public:
+	// returns the path in reverse order (goal first, start last).
+	// Reuses the previous search if it was done on the same map.
+	bool findPath(const LevelMap& map_, const MapCoord& a, const MapCoord& b,
+		std::vector<MapCoord>& path);
+
+	// forgets the previous search.
+	void clear() { map = nullptr; }
+
+	// number of nodes expanded by the last search.
+	size_t ExpandedNodes() const { return expandedNodes; }
+};
@@ -0,0 +1,149 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// Binary min-heap of items (dense indexes in [0, capacity)) that tracks the
+// position of each item, so keys can be updated and items removed in O(log n).
+template <class Key>
+class IndexedHeap
+{
+private:
+	std::vector<std::pair<Key, uint32_t>> heap;
+	std::vector<uint32_t> positions; // heap index + 1, 0 if not in the heap
+
+	void place(size_t heapIdx, const std::pair<Key, uint32_t>& elem)
+	{
+		heap[heapIdx] = elem;
+		positions[elem.second] = (uint32_t)heapIdx + 1;
+	}
+
+	void siftUp(size_t heapIdx)
+	{
+		auto elem = heap[heapIdx];
+		while (heapIdx > 0)
+		{
+			auto parentIdx = (heapIdx - 1) / 2;
+			if ((elem.first < heap[parentIdx].first) == false)
+			{
+				break;
+			}
+			place(heapIdx, heap[parentIdx]);
+			heapIdx = parentIdx;
+		}
+		place(heapIdx, elem);
+	}
+
+	void siftDown(size_t heapIdx)
+	{
+		auto elem = heap[heapIdx];
+		auto heapSize = heap.size();
+		while (true)
+		{
+			auto childIdx = heapIdx * 2 + 1;
+			if (childIdx >= heapSize)
+			{
+				break;
+			}
+			if (childIdx + 1 < heapSize &&
+				heap[childIdx + 1].first < heap[childIdx].first)
+			{
+				childIdx++;
+			}
+			if ((heap[childIdx].first < elem.first) == false)
+			{
+				break;
+			}
+			place(heapIdx, heap[childIdx]);
+			heapIdx = childIdx;
+		}
+		place(heapIdx, elem);
+	}
+
+public:
+	size_t capacity() const { return positions.size(); }
+
+	// clears the heap and sets the maximum number of distinct items.
+	void resize(size_t capacity_)
+	{
+		heap.clear();
+		positions.assign(capacity_, 0);
+	}
+
+	// O(size) - only touches the items that are still in the heap.
+	void clear()
+	{
+		for (const auto& elem : heap)
+		{
+			positions[elem.second] = 0;
+		}
+		heap.clear();
+	}
+
+	bool empty() const { return heap.empty(); }
+	size_t size() const { return heap.size(); }
+
+	bool contains(uint32_t item) const { return positions[item] != 0; }
+
+	const Key& key(uint32_t item) const { return heap[positions[item] - 1].first; }
+
+	uint32_t top() const { return heap.front().second; }
+	const Key& topKey() const { return heap.front().first; }
+
+	// inserts the item or updates its key if it is already in the heap.
+	void push(uint32_t item, const Key& key_)
+	{
+		auto pos = positions[item];
+		if (pos == 0)
+		{
+			heap.push_back(std::make_pair(key_, item));
+			siftUp(heap.size() - 1);
+			return;
+		}
+		auto heapIdx = pos - 1;
+		if (key_ < heap[heapIdx].first)
+		{
+			heap[heapIdx].first = key_;
+			siftUp(heapIdx);
+		}
+		else
+		{
+			heap[heapIdx].first = key_;
+			siftDown(heapIdx);
+		}
+	}
+
+	uint32_t pop()
+	{
+		auto item = heap.front().second;
+		remove(item);
+		return item;
+	}
+
+	void remove(uint32_t item)
+	{
+		auto pos = positions[item];
+		if (pos == 0)
+		{
+			return;
+		}
+		auto heapIdx = pos - 1;
+		positions[item] = 0;
+		auto last = heap.back();
+		heap.pop_back();
+		if (heapIdx < heap.size())
+		{
+			place(heapIdx, last);
+			if (heapIdx > 0 && last.first < heap[(heapIdx - 1) / 2].first)
+			{
+				siftUp(heapIdx);
+			}
+			else
+			{
+				siftDown(heapIdx);
+			}
+		}
+	}
+};
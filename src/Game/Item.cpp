@@ -24,9 +24,9 @@ void Item::executeAction(Game& game) const
 void Item::MapPosition(Level& level, const MapCoord& pos)
 {
 	auto oldObj = level.Map()[mapPosition].getObject(this);
-	level.Map()[mapPosition].deleteObject(this);
+	level.Map().deleteObject(mapPosition, this);
 	mapPosition = pos;
-	level.Map()[mapPosition].addFront(oldObj);
+	level.Map().addFront(mapPosition, oldObj);
 }
 
 void Item::update(Game& game, Level& level)
@@ -315,6 +315,49 @@ void Level::onTouchBegan(Game& game)
 	}
 }
 
+void Level::setWalkPath(Player& player, const MapCoord& b)
+{
+	if (asyncPathFinder == false)
+	{
+		player.setWalkPath(map.getPath(player.MapPosition(), b));
+		return;
+	}
+	pathJobs.cancel(player.PathTicket());
+	player.PathTicket(0);
+	std::vector<MapCoord> path;
+	auto ticket = pathJobs.request(map, player.MapPosition(), b, path);
+	if (ticket == 0)
+	{
+		player.setWalkPath(path);
+		return;
+	}
+	player.clearWalkPath();
+	player.PathTicket(ticket);
+}
+
+void Level::updatePathJobs()
+{
+	pathJobs.update();
+	pathJobs.takeResults(pathJobResults);
+	if (pathJobResults.empty() == true)
+	{
+		return;
+	}
+	for (auto& player : players)
+	{
+		if (player->PathTicket() == 0)
+		{
+			continue;
+		}
+		auto it = pathJobResults.find(player->PathTicket());
+		if (it != pathJobResults.end())
+		{
+			player->PathTicket(0);
+			player->setWalkPath(it->second);
+		}
+	}
+}
+
 void Level::update(Game& game)
 {
 	if (visible == false)
@@ -331,6 +374,10 @@ void Level::update(Game& game)
 		return;
 	}
 
+	{
+		ProfilerScope scope(game.getProfiler(), "pathJobs");
+		updatePathJobs();
+	}
 	updateZoom(game);
 	updateMouse(game);
 
@@ -361,14 +408,19 @@ void Level::update(Game& game)
 		hasMouseInside = false;
 	}
 
-	for (auto& obj : levelObjects)
 	{
-		obj->update(game, *this);
+		ProfilerScope scope(game.getProfiler(), "levelObjects");
+		for (auto& obj : levelObjects)
+		{
+			obj->update(game, *this);
+		}
 	}
-
-	for (auto& player : players)
 	{
-		player->update(game, *this);
+		ProfilerScope scope(game.getProfiler(), "players");
+		for (auto& player : players)
+		{
+			player->update(game, *this);
+		}
 	}
 
 	if (followCurrentPlayer == true && currentPlayer != nullptr)
@@ -378,6 +430,26 @@ void Level::update(Game& game)
 	}
 }
 
+void Level::interpolate(float alpha)
+{
+	if (visible == false)
+	{
+		return;
+	}
+	if (pause == true)
+	{
+		alpha = 1.f;
+	}
+	for (auto& player : players)
+	{
+		player->interpolate(alpha);
+	}
+	if (followCurrentPlayer == true && currentPlayer != nullptr)
+	{
+		view.setCenter(currentPlayer->getBasePosition());
+	}
+}
+
 bool Level::getProperty(const std::string& prop, Variable& var) const
 {
 	if (prop.size() <= 1)
@@ -452,6 +524,44 @@ bool Level::getProperty(const std::string& prop, Variable& var) const
 	return false;
 }
 
+bool Level::queryProperty(const PropertyPath& path, size_t idx, Variable& var) const
+{
+	if (idx + 1 < path.size())
+	{
+		const Queryable* queryable = nullptr;
+		switch (path[idx].hash)
+		{
+		case str2int16("clickedObject"):
+			queryable = clickedObject;
+			break;
+		case str2int16("currentPlayer"):
+			queryable = currentPlayer;
+			break;
+		case str2int16("hoverObject"):
+			queryable = hoverObject;
+			break;
+		case str2int16("player"):
+		{
+			for (const auto& player : players)
+			{
+				if (player->Id() == path[idx + 1].name)
+				{
+					return player->queryProperty(path, idx + 2, var);
+				}
+			}
+			break;
+		}
+		default:
+			break;
+		}
+		if (queryable != nullptr)
+		{
+			return queryable->queryProperty(path, idx + 1, var);
+		}
+	}
+	return getProperty(path.getString(idx), var);
+}
+
 const Queryable* Level::getQueryable(const std::string& prop) const
 {
 	if (prop.empty() == true)
@@ -634,7 +744,7 @@ bool Level::setItem(const MapCoord& mapCoord, const std::shared_ptr<Item>& item)
 		if (oldItem != nullptr)
 		{
 			deleteLevelObject(oldItem.get());
-			mapCel.deleteObject(oldItem.get());
+			map.deleteObject(mapCoord, oldItem.get());
 		}
 		return true;
 	}
@@ -643,7 +753,7 @@ bool Level::setItem(const MapCoord& mapCoord, const std::shared_ptr<Item>& item)
 	{
 		item->MapPosition(mapCoord);
 		item->updateDrawPosition(*this);
-		mapCel.addFront(item);
+		map.addFront(mapCoord, item);
 		addLevelObject(item);
 		return true;
 	}
@@ -731,12 +841,10 @@ void Level::updateLevelObjectPositions()
 {
 	for (auto& obj : levelObjects)
 	{
-		const auto& mapPosition = obj->MapPosition();
-		map[mapPosition.x][mapPosition.y].addBack(obj);
+		map.addBack(obj->MapPosition(), obj);
 	}
 	for (auto& obj : players)
 	{
-		const auto& mapPosition = obj->MapPosition();
-		map[mapPosition.x][mapPosition.y].addBack(obj);
+		map.addBack(obj->MapPosition(), obj);
 	}
 }
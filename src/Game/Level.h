@@ -9,6 +9,7 @@
 #include "Min.h"
 #include "Namer.h"
 #include "Palette.h"
+#include "PathJobQueue.h"
 #include "Player.h"
 #include "PlayerClass.h"
 #include "Quest.h"
@@ -36,6 +37,10 @@ private:
 
 	LevelMap map;
 
+	PathJobQueue pathJobs;
+	PathJobQueue::Results pathJobResults;
+	bool asyncPathFinder{ false };
+
 	sf::Vector2f mousePositionf;
 	bool hasMouseInside{ false };
 
@@ -83,6 +88,8 @@ private:
 
 	void updateMouse(const Game& game);
 
+	void updatePathJobs();
+
 	void onMouseButtonPressed(Game& game);
 	void onMouseScrolled(Game& game);
 	void onTouchBegan(Game& game);
@@ -239,6 +246,15 @@ public:
 
 	void FollowCurrentPlayer(bool follow) { followCurrentPlayer = follow; }
 
+	PathJobQueue& PathJobs() { return pathJobs; }
+
+	bool AsyncPathFinder() const { return asyncPathFinder; }
+	void AsyncPathFinder(bool async) { asyncPathFinder = async; }
+
+	// sets the player's walk path to b. With the async path finder, the
+	// player stops and gets the path in a later frame.
+	void setWalkPath(Player& player, const MapCoord& b);
+
 	void updateLevelObjectPositions();
 
 	virtual bool Pause() const { return pause; }
@@ -252,8 +268,10 @@ public:
 
 	virtual void draw(sf::RenderTarget& target, sf::RenderStates states) const;
 	virtual void update(Game& game);
+	virtual void interpolate(float alpha);
 	virtual bool getProperty(const std::string& prop, Variable& var) const;
 	virtual const Queryable* getQueryable(const std::string& prop) const;
+	virtual bool queryProperty(const PropertyPath& path, size_t idx, Variable& var) const;
 
 	std::shared_ptr<Item> getItem(const MapCoord& mapCoord) const;
 	std::shared_ptr<Item> getItem(const ItemCoordInventory& itemCoord) const;
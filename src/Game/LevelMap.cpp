@@ -1,8 +1,17 @@
 #include "LevelMap.h"
-#include "PathFinder.h"
+#include <cstdlib>
+#include <limits>
 
 int LevelMap::tileSize = 32;
 
+// abstract segments (cluster crossings) refined at a time in hierarchical mode
+static const size_t hierarchicalRefineSegments = 2;
+
+static const size_t maxPassableChanges = 256;
+
+// how far from a blocked tile to look for a cell to walk to
+static const Coord maxNearestCellDistance = 32;
+
 LevelMap::LevelMap(Coord width_, Coord height_) : mapSize(width_, height_)
 {
 	if (mapSize.x == std::numeric_limits<Coord>::max())
@@ -83,6 +92,72 @@ void LevelMap::setArea(Coord x, Coord y, const Dun& dun, const TileSet& til, con
 			}
 		}
 	}
+	hierarchicalPathFinder.invalidate();
+	flowFields.invalidate();
+	regions.invalidate();
+	passableChangeCount++;
+	passableChangesStart = passableChangeCount;
+}
+
+void LevelMap::passableChanged(const MapCoord& coord)
+{
+	hierarchicalPathFinder.invalidate(coord);
+	regions.invalidate(*this, coord);
+
+	if (passableChanges.empty() == true)
+	{
+		passableChanges.resize(maxPassableChanges);
+	}
+	passableChanges[passableChangeCount % maxPassableChanges] = coord;
+	passableChangeCount++;
+}
+
+bool LevelMap::getPassableChanges(uint32_t changeCount, std::vector<MapCoord>& changes) const
+{
+	auto numChanges = passableChangeCount - changeCount;
+	if (numChanges > maxPassableChanges ||
+		numChanges > passableChangeCount - passableChangesStart)
+	{
+		return false;
+	}
+	for (auto i = changeCount; i != passableChangeCount; i++)
+	{
+		changes.push_back(passableChanges[i % maxPassableChanges]);
+	}
+	return true;
+}
+
+void LevelMap::addFront(const MapCoord& coord, const std::shared_ptr<LevelObject>& obj)
+{
+	auto& cell = get(coord.x, coord.y, *this);
+	auto passable = cell.Passable();
+	cell.addFront(obj);
+	if (passable != cell.Passable())
+	{
+		passableChanged(coord);
+	}
+}
+
+void LevelMap::addBack(const MapCoord& coord, const std::shared_ptr<LevelObject>& obj)
+{
+	auto& cell = get(coord.x, coord.y, *this);
+	auto passable = cell.Passable();
+	cell.addBack(obj);
+	if (passable != cell.Passable())
+	{
+		passableChanged(coord);
+	}
+}
+
+void LevelMap::deleteObject(const MapCoord& coord, LevelObject* obj)
+{
+	auto& cell = get(coord.x, coord.y, *this);
+	auto passable = cell.Passable();
+	cell.deleteObject(obj);
+	if (passable != cell.Passable())
+	{
+		passableChanged(coord);
+	}
 }
 
 sf::Vector2f LevelMap::getCoord(const MapCoord& tile) const
@@ -154,77 +229,90 @@ MapCoord LevelMap::getTile(const sf::Vector2f& coords) const
 	return MapCoord((Coord)isoPosX, (Coord)isoPosY);
 }
 
-std::vector<MapCoord> LevelMap::getPath(const MapCoord& a, const MapCoord& b) const
+bool LevelMap::getPathGoal(const MapCoord& a, const MapCoord& b,
+	MapCoord& goal, std::vector<MapCoord>& path) const
 {
-	std::vector<MapCoord> path;
-
 	if (a == b)
 	{
 		path.push_back(a);
-		return path;
+		return false;
 	}
 
-	MapSearchNode start(this, a.x, a.y, PlayerDirection::All);
-	MapSearchNode end(this, b.x, b.y, PlayerDirection::All);
-	MapSearchNode endOrig(end);
-
-	if (end.IsValid() == false)
+	if (b.x >= mapSize.x || b.y >= mapSize.y)
 	{
-		return path;
+		return false;
 	}
-	if (end.IsPassable() == false)
+	const auto& cell = get(b.x, b.y, *this);
+	if (cell.Passable() == true)
 	{
-		if (((*this)[b]).hasObjects() == true)
+		if (regions.isReachable(*this, a, b) == true)
 		{
-			if (start.GoalDistanceEstimateC(end) == 1.f ||
-				getNearestPassableEndNode(start, end) == false)
-			{
-				path.push_back(b);
-				return path;
-			}
-			if (end.IsPassableIgnoreObject() == false)
-			{
-				return path;
-			}
-		}
-		else
-		{
-			return path;
+			goal = b;
+			return true;
 		}
+		// no path to b, walk as close to it as possible
+		return nearestCellFinder.find(*this, regions, a, b, maxNearestCellDistance, goal);
 	}
-
-	PathFinder pathFinder(PATH_FINDER_MAX);
-	pathFinder.SetStartAndGoalStates(start, end);
-
-	unsigned int SearchState;
-	do
+	if (cell.hasObjects() == true)
 	{
-		SearchState = pathFinder.SearchStep();
-		if (pathFinder.GetStepCount() == PATH_FINDER_MAX)
+		// walk next to the object and then interact with it
+		path.push_back(b);
+		if (std::abs((int)a.x - (int)b.x) + std::abs((int)a.y - (int)b.y) == 1 ||
+			nearestCellFinder.find(*this, regions, a, b, 1, goal) == false)
 		{
-			pathFinder.CancelSearch();
+			return false;
 		}
-	} while (SearchState == PathFinder::SEARCH_STATE_SEARCHING);
+		return true;
+	}
+	// blocked tile, walk as close to it as possible
+	return nearestCellFinder.find(*this, regions, a, b, maxNearestCellDistance, goal);
+}
 
-	if (SearchState == PathFinder::SEARCH_STATE_SUCCEEDED)
+std::vector<MapCoord> LevelMap::getPath(const MapCoord& a, const MapCoord& b, PathFinderMode mode) const
+{
+	std::vector<MapCoord> path;
+	MapCoord goal;
+	if (getPathGoal(a, b, goal, path) == false)
 	{
-		if (endOrig.IsPassable() == false)
-		{
-			path.push_back(MapCoord(endOrig.x, endOrig.y));
-		}
-		auto node = pathFinder.GetSolutionEnd();
-		while (true)
-		{
-			if (node == nullptr)
-			{
-				break;
-			}
-			path.push_back(MapCoord(node->x, node->y));
-			node = pathFinder.GetSolutionPrev();
-		};
-		pathFinder.FreeSolutionNodes();
+		return path;
+	}
+	bool found;
+	if (mode == PathFinderMode::Hierarchical)
+	{
+		found = hierarchicalPathFinder.findPath(*this, a, goal, path, hierarchicalRefineSegments);
+	}
+	else
+	{
+		found = pathFinder.findPath(*this, a, goal, mode, path);
+	}
+	if (found == false)
+	{
+		path.clear();
 	}
-	pathFinder.EnsureMemoryFreed();
 
 	return path;
 }
+
+void LevelMap::updatePathFinder() const
+{
+	regions.update(*this);
+	if (pathFinderMode == PathFinderMode::Hierarchical)
+	{
+		hierarchicalPathFinder.update(*this);
+	}
+}
+
+bool LevelMap::isReachable(const MapCoord& a, const MapCoord& b) const
+{
+	return regions.isReachable(*this, a, b);
+}
+
+std::shared_ptr<const FlowField> LevelMap::getFlowField(const MapCoord& goal) const
+{
+	return flowFields.get(*this, goal);
+}
+
+bool LevelMap::refinePath(const MapCoord& a, std::vector<MapCoord>& path) const
+{
+	return hierarchicalPathFinder.refinePath(*this, a, path, hierarchicalRefineSegments);
+}
@@ -1,10 +1,15 @@
 #pragma once
 
+#include "ConnectedRegions.h"
 #include <cstdint>
 #include "Dun.h"
+#include "FlowField.h"
+#include "GridPathFinder.h"
 #include "Helper2D.h"
+#include "HierarchicalPathFinder.h"
 #include "LevelCell.h"
 #include "MapCoord.h"
+#include "NearestCellFinder.h"
 #include "TileSet.h"
 #include "Sol.h"
 #include <vector>
@@ -17,6 +22,19 @@ private:
 	std::vector<LevelCell> cells;
 	MapCoord mapSize;
 
+	// the most recent passability changes, for path finders that keep their own state
+	std::vector<MapCoord> passableChanges;
+	uint32_t passableChangeCount{ 0 };
+	// changes before this one aren't logged (setArea changes every cell)
+	uint32_t passableChangesStart{ 0 };
+
+	mutable GridPathFinder pathFinder;
+	mutable HierarchicalPathFinder hierarchicalPathFinder;
+	mutable FlowFieldCache flowFields;
+	mutable NearestCellFinder nearestCellFinder;
+	mutable ConnectedRegions regions;
+	PathFinderMode pathFinderMode{ PathFinderMode::AStar };
+
 	using Coord = decltype(mapSize.x);
 
 	static const LevelCell& get(Coord x, Coord y, const LevelMap& map)
@@ -28,6 +46,8 @@ private:
 		return map.cells[x + y * map.Width()];
 	}
 
+	void passableChanged(const MapCoord& coord);
+
 public:
 	LevelMap() {}
 	LevelMap(Coord width_, Coord height_);
@@ -51,10 +71,70 @@ public:
 
 	const MapCoord& MapSize() const { return mapSize; }
 
+	// use these instead of the LevelCell functions to keep the path finders updated.
+	void addFront(const MapCoord& coord, const std::shared_ptr<LevelObject>& obj);
+	void addBack(const MapCoord& coord, const std::shared_ptr<LevelObject>& obj);
+	void deleteObject(const MapCoord& coord, LevelObject* obj);
+
+	uint32_t PassableChangeCount() const { return passableChangeCount; }
+
+	// appends the cells whose passability changed since PassableChangeCount()
+	// returned changeCount. Returns false if some of them are no longer kept.
+	bool getPassableChanges(uint32_t changeCount, std::vector<MapCoord>& changes) const;
+
+	bool isPassable(int32_t x, int32_t y) const
+	{
+		if (x >= 0 && x < mapSize.x &&
+			y >= 0 && y < mapSize.y)
+		{
+			return get((Coord)x, (Coord)y, *this).Passable();
+		}
+		return false;
+	}
+
+	bool isPassableIgnoreObject(int32_t x, int32_t y) const
+	{
+		if (x >= 0 && x < mapSize.x &&
+			y >= 0 && y < mapSize.y)
+		{
+			return get((Coord)x, (Coord)y, *this).PassableIgnoreObject();
+		}
+		return false;
+	}
+
 	static int TileSize() { return tileSize; }
 
 	sf::Vector2f getCoord(const MapCoord& tile) const;
 	MapCoord getTile(const sf::Vector2f& coords) const;
 
-	std::vector<MapCoord> getPath(const MapCoord& a, const MapCoord& b) const;
+	PathFinderMode getPathFinderMode() const { return pathFinderMode; }
+	void setPathFinderMode(PathFinderMode mode) { pathFinderMode = mode; }
+
+	// true if there's a path from a (which can be taken by the walker) to b.
+	bool isReachable(const MapCoord& a, const MapCoord& b) const;
+
+	// builds the cached path finder data (region labels and the
+	// hierarchical graph, if the current mode uses it).
+	void updatePathFinder() const;
+
+	// gets the cell to search a path to when walking from a to b: b itself,
+	// a reachable cell next to it if b is taken by an object or the reachable
+	// cell closest to it if b is blocked. Returns false if
+	// no search is needed, with the whole path in path. Otherwise, path
+	// has the cells that go before the searched path (paths are reversed).
+	bool getPathGoal(const MapCoord& a, const MapCoord& b,
+		MapCoord& goal, std::vector<MapCoord>& path) const;
+
+	std::vector<MapCoord> getPath(const MapCoord& a, const MapCoord& b) const
+	{
+		return getPath(a, b, pathFinderMode);
+	}
+	std::vector<MapCoord> getPath(const MapCoord& a, const MapCoord& b, PathFinderMode mode) const;
+
+	// gets the (shared) flow field to goal. Fields are kept until the tiles change.
+	std::shared_ptr<const FlowField> getFlowField(const MapCoord& goal) const;
+
+	// paths from the hierarchical path finder are only partially refined.
+	// refines the cells at the back of path (walking from a), if needed.
+	bool refinePath(const MapCoord& a, std::vector<MapCoord>& path) const;
 };
@@ -0,0 +1,98 @@
+#include "NearestCellFinder.h"
+#include <algorithm>
+#include "ConnectedRegions.h"
+#include <cstdlib>
+#include "LevelMap.h"
+
+bool NearestCellFinder::find(const LevelMap& map, ConnectedRegions& regions,
+	const MapCoord& start, const MapCoord& goal, Coord maxDistance, MapCoord& nearest)
+{
+	visitedNodes = 0;
+	if (start.x >= map.Width() || start.y >= map.Height() ||
+		goal.x >= map.Width() || goal.y >= map.Height())
+	{
+		return false;
+	}
+
+	uint32_t startRegions[9];
+	auto numStartRegions = regions.getRegionsAround(map, start, startRegions);
+
+	for (int32_t dist = 0; dist <= (int32_t)maxDistance; dist++)
+	{
+		auto minX = std::max((int32_t)goal.x - dist, 0);
+		auto maxX = std::min((int32_t)goal.x + dist, (int32_t)map.Width() - 1);
+		auto minY = std::max((int32_t)goal.y - dist, 0);
+		auto maxY = std::min((int32_t)goal.y + dist, (int32_t)map.Height() - 1);
+		if (minX > (int32_t)goal.x - dist &&
+			maxX < (int32_t)goal.x + dist &&
+			minY > (int32_t)goal.y - dist &&
+			maxY < (int32_t)goal.y + dist)
+		{
+			// the ring is outside the map on all sides
+			break;
+		}
+
+		auto found = false;
+		uint32_t bestGoalDist = 0;
+		uint32_t bestStartDist = 0;
+		auto checkCell = [&](int32_t x, int32_t y)
+		{
+			visitedNodes++;
+			if (x != start.x || y != start.y)
+			{
+				auto region = regions.getRegion(map, MapCoord((Coord)x, (Coord)y));
+				if (region == 0 ||
+					std::find(startRegions, startRegions + numStartRegions, region) ==
+					startRegions + numStartRegions)
+				{
+					return;
+				}
+			}
+			auto dx = x - (int32_t)goal.x;
+			auto dy = y - (int32_t)goal.y;
+			auto goalDist = (uint32_t)(dx * dx + dy * dy);
+			auto startDist = (uint32_t)std::max(
+				std::abs(x - (int32_t)start.x), std::abs(y - (int32_t)start.y));
+			if (found == false ||
+				startDist < bestStartDist ||
+				(startDist == bestStartDist && goalDist < bestGoalDist))
+			{
+				found = true;
+				bestGoalDist = goalDist;
+				bestStartDist = startDist;
+				nearest = MapCoord((Coord)x, (Coord)y);
+			}
+		};
+
+		for (auto x = minX; x <= maxX; x++)
+		{
+			if (minY == (int32_t)goal.y - dist)
+			{
+				checkCell(x, minY);
+			}
+			if (maxY == (int32_t)goal.y + dist && maxY != minY)
+			{
+				checkCell(x, maxY);
+			}
+		}
+		// the rows above already checked the corners, unless they're outside the map
+		auto columnMinY = (minY == (int32_t)goal.y - dist ? minY + 1 : minY);
+		auto columnMaxY = (maxY == (int32_t)goal.y + dist ? maxY - 1 : maxY);
+		for (auto y = columnMinY; y <= columnMaxY; y++)
+		{
+			if (minX == (int32_t)goal.x - dist)
+			{
+				checkCell(minX, y);
+			}
+			if (maxX == (int32_t)goal.x + dist && maxX != minX)
+			{
+				checkCell(maxX, y);
+			}
+		}
+		if (found == true)
+		{
+			return true;
+		}
+	}
+	return false;
+}
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include "MapCoord.h"
+
+class ConnectedRegions;
+class LevelMap;
+
+// Finds the passable cell closest to a goal that can be walked to from a
+// start cell. The rings of cells around the goal are checked from the
+// inside out and the map's region labels tell which cells can be reached,
+// so blocked areas of any shape take the same time.
+class NearestCellFinder
+{
+private:
+	size_t visitedNodes{ 0 };
+
+public:
+	// checks the cells up to maxDistance cells (Chebyshev distance) away from
+	// goal. Among the cells in the closest ring, the one nearest to start (and
+	// then to goal) is picked. start itself counts as reachable.
+	bool find(const LevelMap& map, ConnectedRegions& regions,
+		const MapCoord& start, const MapCoord& goal, Coord maxDistance, MapCoord& nearest);
+
+	// number of cells checked by the last search.
+	size_t VisitedNodes() const { return visitedNodes; }
+};
@@ -0,0 +1,138 @@
+#include "PathFinderBenchmark.h"
+#include <algorithm>
+#include <chrono>
+#include "GridPathFinder.h"
+#include "HierarchicalPathFinder.h"
+#include <iomanip>
+#include "LevelMap.h"
+#include <random>
+#include <sstream>
+
+namespace PathFinderBenchmark
+{
+	static const char* getModeName(PathFinderMode mode)
+	{
+		switch (mode)
+		{
+		case PathFinderMode::AStar:
+			return "aStar";
+		case PathFinderMode::JPS:
+			return "jps";
+		case PathFinderMode::Hierarchical:
+			return "hpa";
+		default:
+			return "";
+		}
+	}
+
+	std::vector<Result> run(const LevelMap& map, size_t numSearches, uint32_t seed)
+	{
+		std::vector<Result> results;
+
+		std::vector<MapCoord> passableCells;
+		for (Coord j = 0; j < map.Height(); j++)
+		{
+			for (Coord i = 0; i < map.Width(); i++)
+			{
+				if (map.isPassable(i, j) == true)
+				{
+					passableCells.push_back(MapCoord(i, j));
+				}
+			}
+		}
+		if (passableCells.size() < 2)
+		{
+			return results;
+		}
+
+		std::mt19937 mt(seed);
+		std::uniform_int_distribution<size_t> dist(0, passableCells.size() - 1);
+		std::vector<std::pair<MapCoord, MapCoord>> searches;
+		for (size_t i = 0; i < numSearches; i++)
+		{
+			searches.push_back(std::make_pair(passableCells[dist(mt)], passableCells[dist(mt)]));
+		}
+
+		GridPathFinder pathFinder;
+		// the cluster graph is built once, before any search is timed
+		HierarchicalPathFinder hierarchicalPathFinder;
+		hierarchicalPathFinder.update(map);
+		std::vector<size_t> firstLengths(searches.size());
+		std::vector<MapCoord> path;
+
+		for (size_t i = 0; i < (size_t)PathFinderMode::Size; i++)
+		{
+			Result result;
+			result.mode = (PathFinderMode)i;
+			for (size_t j = 0; j < searches.size(); j++)
+			{
+				path.clear();
+				auto startTime = std::chrono::high_resolution_clock::now();
+				bool found;
+				size_t expandedNodes;
+				if (result.mode == PathFinderMode::Hierarchical)
+				{
+					found = hierarchicalPathFinder.findPath(map, searches[j].first,
+						searches[j].second, path);
+					expandedNodes = hierarchicalPathFinder.ExpandedNodes();
+				}
+				else
+				{
+					found = pathFinder.findPath(map, searches[j].first,
+						searches[j].second, result.mode, path);
+					expandedNodes = pathFinder.ExpandedNodes();
+				}
+				auto endTime = std::chrono::high_resolution_clock::now();
+				auto elapsed = std::chrono::duration<double, std::micro>(endTime - startTime).count();
+
+				result.searches++;
+				result.totalMicroseconds += elapsed;
+				result.maxMicroseconds = std::max(result.maxMicroseconds, elapsed);
+				result.expandedNodes += expandedNodes;
+				if (found == true)
+				{
+					result.pathsFound++;
+					result.totalPathLength += path.size();
+				}
+				if (i == 0)
+				{
+					firstLengths[j] = path.size();
+				}
+				else if (firstLengths[j] != path.size())
+				{
+					result.lengthMismatches++;
+				}
+			}
+			results.push_back(result);
+		}
+		return results;
+	}
+
+	std::string toString(const std::vector<Result>& results)
+	{
+		std::stringstream ss;
+		ss << std::left << std::setw(8) << "mode"
+			<< std::right << std::setw(10) << "searches"
+			<< std::setw(8) << "found"
+			<< std::setw(12) << "avg (us)"
+			<< std::setw(12) << "max (us)"
+			<< std::setw(12) << "avg nodes"
+			<< std::setw(12) << "avg length"
+			<< std::setw(12) << "mismatches" << "\n";
+		ss << std::fixed << std::setprecision(2);
+		for (const auto& result : results)
+		{
+			auto searches = (double)std::max(result.searches, (size_t)1);
+			auto found = (double)std::max(result.pathsFound, (size_t)1);
+			ss << std::left << std::setw(8) << getModeName(result.mode)
+				<< std::right << std::setw(10) << result.searches
+				<< std::setw(8) << result.pathsFound
+				<< std::setw(12) << result.totalMicroseconds / searches
+				<< std::setw(12) << result.maxMicroseconds
+				<< std::setw(12) << (double)result.expandedNodes / searches
+				<< std::setw(12) << (double)result.totalPathLength / found
+				<< std::setw(12) << result.lengthMismatches << "\n";
+		}
+		return ss.str();
+	}
+}
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include "GameProperties.h"
+#include <string>
+#include <vector>
+
+class LevelMap;
+
+namespace PathFinderBenchmark
+{
+	struct Result
+	{
+		PathFinderMode mode{ PathFinderMode::AStar };
+		size_t searches{ 0 };
+		size_t pathsFound{ 0 };
+		size_t totalPathLength{ 0 };
+		size_t expandedNodes{ 0 };
+		// searches whose path length differs from the first mode's result
+		// (hierarchical paths are near optimal, so some are expected there)
+		size_t lengthMismatches{ 0 };
+		double totalMicroseconds{ 0.0 };
+		double maxMicroseconds{ 0.0 };
+	};
+
+	// runs the same random pairs of passable cells through every path finder mode.
+	std::vector<Result> run(const LevelMap& map, size_t numSearches, uint32_t seed);
+
+	std::string toString(const std::vector<Result>& results);
+}
@@ -0,0 +1,249 @@
+#include "PathJobQueue.h"
+#include <algorithm>
+#include <system_error>
+
+PathJobQueue::~PathJobQueue()
+{
+#ifndef USE_PATH_FINDER_NO_THREAD
+	stopWorkerThread();
+#endif
+}
+
+#ifndef USE_PATH_FINDER_NO_THREAD
+void PathJobQueue::startWorker()
+{
+	if (worker.joinable() == true)
+	{
+		return;
+	}
+	try
+	{
+		stopWorker = false;
+		worker = std::thread(&PathJobQueue::runWorker, this);
+	}
+	catch (const std::system_error&)
+	{
+		// no worker, run the jobs on the main thread
+		useWorker = false;
+	}
+}
+
+void PathJobQueue::stopWorkerThread()
+{
+	if (worker.joinable() == false)
+	{
+		return;
+	}
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		stopWorker = true;
+	}
+	condition.notify_all();
+	worker.join();
+	stopWorker = false;
+}
+
+void PathJobQueue::runWorker()
+{
+	while (true)
+	{
+		Job job;
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			condition.wait(lock, [this] { return stopWorker == true || pendingJobs.empty() == false; });
+			if (stopWorker == true)
+			{
+				return;
+			}
+			job = std::move(pendingJobs.front());
+			pendingJobs.pop_front();
+		}
+		runJob(job);
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			// dropped with the mutex held, see getSnapshot
+			job.map = nullptr;
+			completedJobs[job.ticket] = std::move(job.path);
+		}
+	}
+}
+#endif
+
+void PathJobQueue::UseWorker(bool useWorker_)
+{
+	useWorker = useWorker_;
+#ifndef USE_PATH_FINDER_NO_THREAD
+	if (useWorker == false)
+	{
+		// the pending jobs run on the main thread from now on
+		stopWorkerThread();
+	}
+#endif
+}
+
+std::shared_ptr<const LevelMap> PathJobQueue::getSnapshot(const LevelMap& map)
+{
+	if (snapshot.map != nullptr &&
+		snapshot.source == &map &&
+		snapshot.changeCount == map.PassableChangeCount() &&
+		snapshot.map->MapSize() == map.MapSize())
+	{
+		return snapshot.map;
+	}
+	// queued jobs keep using the old snapshot, if there are any. Jobs only
+	// drop their snapshot with the mutex held and only this thread adds
+	// jobs, so a snapshot that isn't used here stays unused after unlocking.
+	bool inUse;
+	bool spareInUse;
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		inUse = snapshot.map.use_count() > 1;
+		spareInUse = spareSnapshot.map.use_count() > 1;
+	}
+	if (inUse == true)
+	{
+		std::swap(snapshot, spareSnapshot);
+		if (spareInUse == true)
+		{
+			snapshot = Snapshot();
+		}
+	}
+
+	// only the cells that changed since the snapshot was taken are copied,
+	// unless the map's change log doesn't go back that far.
+	snapshotChanges.clear();
+	if (snapshot.map != nullptr &&
+		snapshot.source == &map &&
+		snapshot.map->MapSize() == map.MapSize() &&
+		map.getPassableChanges(snapshot.changeCount, snapshotChanges) == true)
+	{
+		for (const auto& cell : snapshotChanges)
+		{
+			(*snapshot.map)[cell].Sol(map[cell].Passable() == true ? 0 : 1);
+		}
+	}
+	else
+	{
+		if (snapshot.map == nullptr ||
+			snapshot.map->MapSize() != map.MapSize())
+		{
+			snapshot.map = std::make_shared<LevelMap>(map.Width(), map.Height());
+		}
+		for (Coord j = 0; j < map.Height(); j++)
+		{
+			for (Coord i = 0; i < map.Width(); i++)
+			{
+				(*snapshot.map)[i][j].Sol(map[i][j].Passable() == true ? 0 : 1);
+			}
+		}
+	}
+	snapshot.source = &map;
+	snapshot.changeCount = map.PassableChangeCount();
+	return snapshot.map;
+}
+
+void PathJobQueue::runJob(Job& job)
+{
+	auto mode = job.mode;
+	if (mode == PathFinderMode::Hierarchical)
+	{
+		mode = PathFinderMode::JPS;
+	}
+	if (pathFinder.findPath(*job.map, job.start, job.goal, mode, job.path) == false)
+	{
+		job.path.clear();
+	}
+}
+
+PathJobQueue::Ticket PathJobQueue::request(const LevelMap& map,
+	const MapCoord& a, const MapCoord& b, std::vector<MapCoord>& path)
+{
+	Job job;
+	if (map.getPathGoal(a, b, job.goal, path) == false)
+	{
+		return 0;
+	}
+	lastTicket++;
+	if (lastTicket == 0)
+	{
+		lastTicket++;
+	}
+	job.ticket = lastTicket;
+	job.map = getSnapshot(map);
+	job.start = a;
+	job.mode = map.getPathFinderMode();
+	job.path = std::move(path);
+	path.clear();
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		pendingJobs.push_back(std::move(job));
+	}
+#ifndef USE_PATH_FINDER_NO_THREAD
+	if (useWorker == true)
+	{
+		startWorker();
+		condition.notify_one();
+	}
+#endif
+	return lastTicket;
+}
+
+void PathJobQueue::cancel(Ticket ticket)
+{
+	if (ticket == 0)
+	{
+		return;
+	}
+	std::lock_guard<std::mutex> lock(mutex);
+	auto it = std::find_if(pendingJobs.begin(), pendingJobs.end(),
+		[ticket](const Job& job) { return job.ticket == ticket; });
+	if (it != pendingJobs.end())
+	{
+		pendingJobs.erase(it);
+	}
+	completedJobs.erase(ticket);
+}
+
+void PathJobQueue::update()
+{
+#ifndef USE_PATH_FINDER_NO_THREAD
+	if (useWorker == true)
+	{
+		return;
+	}
+#endif
+	for (size_t i = 0; mainThreadBudget == 0 || i < mainThreadBudget; i++)
+	{
+		Job job;
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			if (pendingJobs.empty() == true)
+			{
+				break;
+			}
+			job = std::move(pendingJobs.front());
+			pendingJobs.pop_front();
+		}
+		runJob(job);
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			// dropped with the mutex held, see getSnapshot
+			job.map = nullptr;
+			completedJobs[job.ticket] = std::move(job.path);
+		}
+	}
+}
+
+void PathJobQueue::takeResults(Results& results)
+{
+	results.clear();
+	std::lock_guard<std::mutex> lock(mutex);
+	std::swap(results, completedJobs);
+}
+
+void PathJobQueue::clear()
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	pendingJobs.clear();
+	completedJobs.clear();
+}
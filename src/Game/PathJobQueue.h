@@ -0,0 +1,112 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include "GameProperties.h"
+#include "GridPathFinder.h"
+#include "LevelMap.h"
+#include "MapCoord.h"
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+// Path searches that don't run in the frame they're requested in. Each
+// request gets a ticket and searches a copy of the map's passability, so
+// it can run on a worker thread. Without a worker (or with threads
+// disabled), up to a number of searches run on the main thread per frame.
+class PathJobQueue
+{
+public:
+	using Ticket = uint32_t;
+
+private:
+	struct Job
+	{
+		Ticket ticket{ 0 };
+		std::shared_ptr<const LevelMap> map;
+		MapCoord start;
+		MapCoord goal;
+		PathFinderMode mode{ PathFinderMode::AStar };
+		std::vector<MapCoord> path;
+	};
+
+public:
+	using Results = std::unordered_map<Ticket, std::vector<MapCoord>>;
+
+private:
+	// guards pendingJobs, completedJobs and the jobs dropping their map
+	std::mutex mutex;
+	std::deque<Job> pendingJobs;
+	Results completedJobs;
+	Ticket lastTicket{ 0 };
+
+	struct Snapshot
+	{
+		std::shared_ptr<LevelMap> map;
+		const LevelMap* source{ nullptr };
+		uint32_t changeCount{ 0 };
+	};
+
+	// passability snapshot shared by the jobs requested while the map
+	// doesn't change. The spare one is updated instead while queued jobs
+	// use the current one. Both are updated with the map's passable changes.
+	Snapshot snapshot;
+	Snapshot spareSnapshot;
+	std::vector<MapCoord> snapshotChanges;
+
+	// only used by the thread running the jobs
+	GridPathFinder pathFinder;
+
+	size_t mainThreadBudget{ 4 };
+	bool useWorker{ true };
+
+#ifndef USE_PATH_FINDER_NO_THREAD
+	std::thread worker;
+	std::condition_variable condition;
+	bool stopWorker{ false };
+
+	void startWorker();
+	void stopWorkerThread();
+	void runWorker();
+#endif
+
+	std::shared_ptr<const LevelMap> getSnapshot(const LevelMap& map);
+	void runJob(Job& job);
+
+public:
+	PathJobQueue() {}
+	~PathJobQueue();
+
+	PathJobQueue(const PathJobQueue&) = delete;
+	PathJobQueue& operator=(const PathJobQueue&) = delete;
+
+	size_t MainThreadBudget() const { return mainThreadBudget; }
+	void MainThreadBudget(size_t budget) { mainThreadBudget = budget; }
+
+	bool UseWorker() const { return useWorker; }
+	void UseWorker(bool useWorker_);
+
+	// queues a search for a path from a to b. Returns 0 if there's nothing
+	// to search for, with the result already in path. Hierarchical searches
+	// use jump point search, because the cluster graph belongs to the map.
+	Ticket request(const LevelMap& map, const MapCoord& a, const MapCoord& b,
+		std::vector<MapCoord>& path);
+
+	// drops a request. Its result is never returned.
+	void cancel(Ticket ticket);
+
+	// runs the main thread's share of the pending searches
+	// (all of them if the budget is 0).
+	void update();
+
+	// moves the paths of the completed searches into results
+	// (empty paths if no path was found).
+	void takeResults(Results& results);
+
+	// drops all the pending and completed searches.
+	void clear();
+};
@@ -40,6 +40,7 @@ void Player::updateDrawPosition(sf::Vector2f pos)
 	pos.x += (float)(-(sprite.getTextureRect().width / 2)) + LevelMap::TileSize();
 	pos.y += (float)(224 - (sprite.getTextureRect().height - LevelMap::TileSize()));
 	sprite.setPosition(pos);
+	tickPosition = pos;
 }
 
 void Player::updateTexture()
@@ -95,6 +96,10 @@ void Player::updateWalkPath(Game& game, Level& level)
 	auto newDrawPos = drawPosA;
 	if (drawPosA == drawPosB)
 	{
+		if (hasWalkGoal == true)
+		{
+			updateWalkGoal(level);
+		}
 		if (walkPath.empty() == true &&
 			hasWalkingStatus() == true)
 		{
@@ -111,6 +116,7 @@ void Player::updateWalkPath(Game& game, Level& level)
 				{
 					levelObj->executeAction(game);
 					walkPath.pop_back();
+					hasWalkGoal = false;
 					return;
 				}
 			}
@@ -119,6 +125,16 @@ void Player::updateWalkPath(Game& game, Level& level)
 				walkPath.pop_back();
 				continue;
 			}
+			if (std::abs((int)nextMapPos.x - (int)mapPosition.x) > 1 ||
+				std::abs((int)nextMapPos.y - (int)mapPosition.y) > 1)
+			{
+				// hierarchical paths are refined as they are walked
+				if (level.Map().refinePath(mapPosition, walkPath) == false)
+				{
+					walkPath = level.Map().getPath(mapPosition, walkPath.front());
+				}
+				continue;
+			}
 			setWalkStatus();
 			setDirection(getPlayerDirection(mapPosition, nextMapPos));
 			MapPosition(level, nextMapPos);
@@ -134,12 +150,83 @@ void Player::updateWalkPath(Game& game, Level& level)
 	updateDrawPosition(newDrawPos);
 }
 
+void Player::updateWalkGoal(Level& level)
+{
+	auto target = walkTarget.lock();
+	if (target != nullptr)
+	{
+		walkGoal = target->MapPosition();
+	}
+	walkPath.clear();
+	mapPositionMoveTo = walkGoal;
+
+	// the goal is resolved like in the Path mode: blocked or unreachable
+	// cells are walked to as close as possible and objects are walked next
+	// to (with the object at the front of the path to interact with it).
+	const auto& map = level.Map();
+	MapCoord goal;
+	if (map.getPathGoal(mapPosition, walkGoal, goal, walkPath) == false ||
+		goal == mapPosition)
+	{
+		hasWalkGoal = false;
+		return;
+	}
+	if (walkMode == PlayerWalkMode::FlowField)
+	{
+		auto flowField = map.getFlowField(goal);
+		MapCoord nextMapPos;
+		if (flowField->isReachable(mapPosition) == false)
+		{
+			walkPath.clear();
+			hasWalkGoal = false;
+			return;
+		}
+		if (flowField->getNextStep(map, mapPosition, nextMapPos) == true)
+		{
+			// keep the goal at the front, so objects on the next cell
+			// aren't mistaken for the target.
+			walkPath.push_back(goal);
+			if (nextMapPos != goal)
+			{
+				walkPath.push_back(nextMapPos);
+			}
+			return;
+		}
+		// no closer free cell (an object blocks the way, the field only
+		// knows the tiles), so the path is searched on the current map.
+	}
+	if (incrementalPathFinder == nullptr)
+	{
+		incrementalPathFinder = std::make_unique<IncrementalPathFinder>();
+	}
+	if (incrementalPathFinder->findPath(map, mapPosition, goal, walkPath) == false)
+	{
+		walkPath.clear();
+		if (walkMode != PlayerWalkMode::FlowField)
+		{
+			// flow field walkers wait for the cells to be free again
+			hasWalkGoal = false;
+		}
+	}
+}
+
+void Player::setWalkGoal(const MapCoord& goal, const std::shared_ptr<LevelObject>& target)
+{
+	walkGoal = goal;
+	walkTarget = target;
+	hasWalkGoal = true;
+	pathTicket = 0;
+	mapPositionMoveTo = goal;
+}
+
 void Player::setWalkPath(const std::vector<MapCoord>& walkPath_)
 {
 	if (walkPath_.empty() == true)
 	{
 		return;
 	}
+	hasWalkGoal = false;
+	pathTicket = 0;
 	walkPath = walkPath_;
 	if (walkPath.empty() == false)
 	{
@@ -165,9 +252,9 @@ void Player::executeAction(Game& game) const
 void Player::updateMapPosition(Level& level, const MapCoord& pos)
 {
 	auto oldObj = level.Map()[mapPosition].getObject(this);
-	level.Map()[mapPosition].deleteObject(this);
+	level.Map().deleteObject(mapPosition, this);
 	mapPosition = pos;
-	level.Map()[mapPosition].addBack(oldObj);
+	level.Map().addBack(mapPosition, oldObj);
 }
 
 void Player::MapPosition(Level& level, const MapCoord& pos)
@@ -188,6 +275,7 @@ void Player::move(Level& level, const MapCoord& pos)
 	resetAnimationTime();
 	drawPosA = drawPosB = level.Map().getCoord(pos);
 	updateMapPosition(level, pos);
+	updateDrawPosition();
 }
 
 void Player::update(Game& game, Level& level)
@@ -198,6 +286,9 @@ void Player::update(Game& game, Level& level)
 		return;
 	}
 
+	prevTickPosition = tickPosition;
+	sprite.setPosition(tickPosition);
+
 	currentWalkTime += game.getElapsedTime();
 	if (currentWalkTime >= speed.walk)
 	{
@@ -243,6 +334,13 @@ void Player::update(Game& game, Level& level)
 	}
 }
 
+void Player::interpolate(float alpha)
+{
+	sprite.setPosition(
+		std::round(prevTickPosition.x + (tickPosition.x - prevTickPosition.x) * alpha),
+		std::round(prevTickPosition.y + (tickPosition.y - prevTickPosition.y) * alpha));
+}
+
 bool Player::getProperty(const std::string& prop, Variable& var) const
 {
 	if (prop.empty() == true)
@@ -400,6 +498,41 @@ void Player::setProperty(const std::string& prop, const Variable& val)
 	}
 }
 
+bool Player::queryProperty(const PropertyPath& path, size_t idx, Variable& var) const
+{
+	if (idx + 1 < path.size())
+	{
+		switch (path[idx].hash)
+		{
+		case str2int16("selectedItem"):
+		{
+			if (selectedItem != nullptr)
+			{
+				return selectedItem->queryProperty(path, idx + 1, var);
+			}
+			return false;
+		}
+		case str2int16("item"):
+		{
+			size_t invIdx;
+			size_t itemIdx;
+			if (getInventoryAndItem(path, idx + 1, invIdx, itemIdx) == true)
+			{
+				auto item = inventories[invIdx][itemIdx].get();
+				if (item != nullptr)
+				{
+					return item->queryProperty(path, idx + 3, var);
+				}
+			}
+			return false;
+		}
+		default:
+			break;
+		}
+	}
+	return getProperty(path.getString(idx), var);
+}
+
 const Queryable* Player::getQueryable(const std::string& prop) const
 {
 	if (prop.empty() == true)
@@ -817,6 +950,46 @@ bool Player::parseInventoryAndItem(const std::string& str,
 	return false;
 }
 
+bool Player::getInventoryAndItem(const PropertyPath& path, size_t idx,
+	size_t& invIdx, size_t& itemIdx) const
+{
+	if (idx + 1 >= path.size())
+	{
+		return false;
+	}
+	const auto& invSegment = path[idx];
+	if (invSegment.number != PropertyPath::NotANumber)
+	{
+		invIdx = invSegment.number;
+	}
+	else
+	{
+		invIdx = (size_t)GameUtils::getPlayerInventory(invSegment.name);
+	}
+	if (invIdx >= inventories.size())
+	{
+		return false;
+	}
+	const auto& itemSegment = path[idx + 1];
+	char* end = nullptr;
+	auto num = std::strtoul(itemSegment.name.c_str(), &end, 10);
+	if (*end == ',')
+	{
+		size_t y = std::strtoul(end + 1, NULL, 10);
+		itemIdx = inventories[invIdx].getIndex(num, y);
+	}
+	else if (invIdx == (size_t)PlayerInventory::Body &&
+		itemSegment.number == PropertyPath::NotANumber)
+	{
+		itemIdx = (size_t)GameUtils::getPlayerItemMount(itemSegment.name);
+	}
+	else
+	{
+		itemIdx = num;
+	}
+	return itemIdx < inventories[invIdx].Size();
+}
+
 bool Player::addGold(const Level& level, LevelObjValue amount)
 {
 	if (amount == 0)
@@ -2,6 +2,7 @@
 
 #include "Actions/Action.h"
 #include <cstdint>
+#include "IncrementalPathFinder.h"
 #include "ItemCollection.h"
 #include "LevelObject.h"
 #include <memory>
@@ -18,9 +19,21 @@ private:
 	sf::Vector2f drawPosA;
 	sf::Vector2f drawPosB;
 	float currPositionStep = 0.f;
+	// sprite position after the last update and the one before it,
+	// for drawing in between updates with a fixed timestep.
+	sf::Vector2f tickPosition;
+	sf::Vector2f prevTickPosition;
 
 	std::vector<MapCoord> walkPath;
 
+	PlayerWalkMode walkMode{ PlayerWalkMode::Path };
+	MapCoord walkGoal;
+	std::weak_ptr<LevelObject> walkTarget;
+	bool hasWalkGoal{ false };
+	std::unique_ptr<IncrementalPathFinder> incrementalPathFinder;
+	// pending search in the level's PathJobQueue (0 if none)
+	uint32_t pathTicket{ 0 };
+
 	PlayerDirection direction{ PlayerDirection::All };
 	PlayerStatus status{ PlayerStatus::Size };
 
@@ -100,9 +113,13 @@ private:
 
 	void updateWalkPathStep(sf::Vector2f& newDrawPos);
 	void updateWalkPath(Game& game, Level& level);
+	void updateWalkGoal(Level& level);
 
 	bool parseInventoryAndItem(const std::string& str,
 		std::string& props, size_t& invIdx, size_t& itemIdx) const;
+	// same as parseInventoryAndItem for the segments idx and idx + 1 of a path.
+	bool getInventoryAndItem(const PropertyPath& path, size_t idx,
+		size_t& invIdx, size_t& itemIdx) const;
 
 	void updateGoldAdd(const std::shared_ptr<Item>& item);
 	void updateGoldRemove(const std::shared_ptr<Item>& item);
@@ -145,9 +162,13 @@ public:
 	}
 	virtual void update(Game& game, Level& level);
 
+	// moves the sprite in between the last 2 updates (alpha from 0 to 1).
+	void interpolate(float alpha);
+
 	virtual bool getProperty(const std::string& prop, Variable& var) const;
 	virtual void setProperty(const std::string& prop, const Variable& val);
 	virtual const Queryable* getQueryable(const std::string& prop) const;
+	virtual bool queryProperty(const PropertyPath& path, size_t idx, Variable& var) const;
 
 	bool getIntByHash(uint16_t propHash, LevelObjValue& value) const;
 	bool getInt(const char* prop, LevelObjValue& value) const;
@@ -188,13 +209,35 @@ public:
 	}
 
 	void updateDrawPosition(sf::Vector2f pos);
-	void updateDrawPosition() { updateDrawPosition(drawPosA); }
+	// places the sprite without moving it in between updates.
+	void updateDrawPosition()
+	{
+		updateDrawPosition(drawPosA);
+		prevTickPosition = tickPosition;
+	}
 
 	void updateTexture();
 
-	void clearWalkPath() { walkPath.clear(); }
+	void clearWalkPath()
+	{
+		walkPath.clear();
+		hasWalkGoal = false;
+		walkTarget.reset();
+		pathTicket = 0;
+	}
 	void setWalkPath(const std::vector<MapCoord>& walkPath_);
 
+	uint32_t PathTicket() const { return pathTicket; }
+	void PathTicket(uint32_t ticket) { pathTicket = ticket; }
+
+	PlayerWalkMode getWalkMode() const { return walkMode; }
+	void setWalkMode(PlayerWalkMode walkMode_) { walkMode = walkMode_; }
+
+	// walks to goal (or to target's position, if set) one step at a time,
+	// using the incremental path finder or the map's shared flow fields.
+	void setWalkGoal(const MapCoord& goal,
+		const std::shared_ptr<LevelObject>& target = nullptr);
+
 	void setDefaultSpeed(const AnimationSpeed& speed_)
 	{
 		defaultSpeed = speed_;
@@ -1,6 +1,6 @@
 #include "GameUtils.h"
 #include "Game.h"
-#include <regex>
+#include "TextTemplate.h"
 #include "Utils.h"
 
 namespace GameUtils
@@ -349,6 +349,21 @@ namespace GameUtils
 		return val;
 	}
 
+	PathFinderMode getPathFinderMode(const std::string& str, PathFinderMode val)
+	{
+		switch (str2int16(toLower(str).c_str()))
+		{
+		case str2int16("astar"):
+			return PathFinderMode::AStar;
+		case str2int16("jps"):
+			return PathFinderMode::JPS;
+		case str2int16("hierarchical"):
+			return PathFinderMode::Hierarchical;
+		default:
+			return val;
+		}
+	}
+
 	PlayerDirection getPlayerDirection(const std::string& str, PlayerDirection val)
 	{
 		switch (str2int16(toLower(str).c_str()))
@@ -478,6 +493,21 @@ namespace GameUtils
 		}
 	}
 
+	PlayerWalkMode getPlayerWalkMode(const std::string& str, PlayerWalkMode val)
+	{
+		switch (str2int16(toLower(str).c_str()))
+		{
+		case str2int16("path"):
+			return PlayerWalkMode::Path;
+		case str2int16("incremental"):
+			return PlayerWalkMode::Incremental;
+		case str2int16("flowfield"):
+			return PlayerWalkMode::FlowField;
+		default:
+			return val;
+		}
+	}
+
 	sf::Time getTime(int fps)
 	{
 		fps = std::max(std::min(fps, 1000), 1);
@@ -532,51 +562,54 @@ namespace GameUtils
 		{
 			auto propStr = str.substr(1, str.size() - 2);
 			auto props = splitStringIn2(propStr, '|');
-			const auto& id = props.first;
-			const auto& uiElemProps = props.second;
+			return getObjectProperty(game, props.first, props.second, var);
+		}
+		return false;
+	}
 
-			if (id == "game")
-			{
-				return game.getProperty(uiElemProps, var);
-			}
-			const UIObject* uiObject = game.Resources().getDrawable(id);
-			if (uiObject == nullptr)
+	bool getObjectProperty(const Game& game, const std::string& id,
+		const std::string& prop, Variable& var)
+	{
+		if (id == "game")
+		{
+			return game.getProperty(prop, var);
+		}
+		const UIObject* uiObject = game.Resources().getDrawable(id);
+		if (uiObject == nullptr)
+		{
+			if (id == "focus")
 			{
-				if (id == "focus")
-				{
-					uiObject = game.Resources().getFocused();
-				}
-				else if (id == "currentLevel")
-				{
-					uiObject = game.Resources().getCurrentLevel();
-				}
+				uiObject = game.Resources().getFocused();
 			}
-			if (uiObject != nullptr)
+			else if (id == "currentLevel")
 			{
-				return uiObject->getProperty(uiElemProps, var);
+				uiObject = game.Resources().getCurrentLevel();
 			}
 		}
+		if (uiObject != nullptr)
+		{
+			return uiObject->getProperty(prop, var);
+		}
 		return false;
 	}
 
-	std::regex regexPercent(R"((\%[\w.]+\%))");
-
 	std::string replaceStringWithQueryable(const std::string& str, const Queryable& obj)
 	{
-		std::string str1(str);
-		std::string str2(str1);
-		std::smatch match;
-		while (std::regex_search(str1, match, regexPercent) == true)
-		{
-			auto strProp = match[1].str();
-			Variable var;
-			if (obj.getProperty(strProp.substr(1, strProp.size() - 2), var) == true)
-			{
-				Utils::replaceStringInPlace(
-					str2, strProp, VarUtils::toString(var));
-			}
-			str1 = match.suffix().str();
+		if (TextTemplate::mayHavePlaceholders(str.c_str()) == false)
+		{
+			return str;
 		}
-		return str2;
+		return replaceStringWithQueryable(TextTemplate(str), obj);
+	}
+
+	std::string replaceStringWithQueryable(const TextTemplate& strTemplate, const Queryable& obj)
+	{
+		std::string str;
+		str.reserve(strTemplate.getString().size());
+		strTemplate.render(str, [&obj](const std::string& prop, Variable& var)
+		{
+			return obj.getProperty(prop, var);
+		});
+		return str;
 	}
 }
@@ -6,6 +6,7 @@
 #include "IgnoreResource.h"
 #include <SFML/System/Vector2.hpp>
 #include <string>
+#include "TextTemplate.h"
 #include <vector>
 #include "UIObject.h"
 
@@ -39,6 +40,8 @@ namespace GameUtils
 	InventoryPosition getInventoryPosition(const std::string& str,
 		InventoryPosition val = InventoryPosition::TopLeft);
 
+	PathFinderMode getPathFinderMode(const std::string& str, PathFinderMode val);
+
 	PlayerDirection getPlayerDirection(const std::string& str, PlayerDirection val);
 
 	PlayerInventory getPlayerInventory(const std::string& str,
@@ -55,6 +58,8 @@ namespace GameUtils
 
 	PlayerStatus getPlayerStatus(const std::string& str, PlayerStatus val);
 
+	PlayerWalkMode getPlayerWalkMode(const std::string& str, PlayerWalkMode val);
+
 	sf::Time getTime(int fps);
 
 	bool getUIObjProp(const UIObject& uiObject, const uint16_t propHash16,
@@ -62,5 +67,10 @@ namespace GameUtils
 
 	bool getObjectProperty(const Game& game, const std::string& str, Variable& var);
 
+	// same as above, with "|id|prop|" already split in id and prop.
+	bool getObjectProperty(const Game& game, const std::string& id,
+		const std::string& prop, Variable& var);
+
 	std::string replaceStringWithQueryable(const std::string& str, const Queryable& obj);
+	std::string replaceStringWithQueryable(const TextTemplate& strTemplate, const Queryable& obj);
 }
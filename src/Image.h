@@ -9,6 +9,7 @@ private:
 	sf::Sprite sprite;
 	Anchor anchor{ Anchor::Top | Anchor::Left };
 	bool visible{ true };
+	bool opaque{ false };
 
 public:
 	Image(const sf::Texture& tex) : sprite(tex) {}
@@ -34,6 +35,17 @@ public:
 	virtual bool Visible() const { return visible; }
 	virtual void Visible(bool visible_) { visible = visible_; }
 
+	void Opaque(bool opaque_) { opaque = opaque_; }
+	virtual bool getOpaqueRect(sf::FloatRect& rect) const
+	{
+		if (opaque == true && visible == true)
+		{
+			rect = sprite.getGlobalBounds();
+			return true;
+		}
+		return false;
+	}
+
 	virtual const sf::Vector2f& DrawPosition() const { return sprite.getPosition(); }
 	virtual const sf::Vector2f& Position() const { return sprite.getPosition(); }
 	virtual void Position(const sf::Vector2f& position) { sprite.setPosition(position); }
@@ -0,0 +1,325 @@
+#include "InputRecorder.h"
+#include <cstring>
+
+static const char recordingMagic[4] = { 'D', 'G', 'I', 'R' };
+static const uint8_t recordingVersion = 2;
+
+static void writeUInt(std::vector<uint8_t>& buffer, uint64_t val)
+{
+	while (val >= 0x80)
+	{
+		buffer.push_back((uint8_t)(val | 0x80));
+		val >>= 7;
+	}
+	buffer.push_back((uint8_t)val);
+}
+
+static void writeInt(std::vector<uint8_t>& buffer, int64_t val)
+{
+	writeUInt(buffer, ((uint64_t)val << 1) ^ (uint64_t)(val >> 63));
+}
+
+static void writeFloat(std::vector<uint8_t>& buffer, float val)
+{
+	uint32_t bits;
+	std::memcpy(&bits, &val, sizeof(bits));
+	writeUInt(buffer, bits);
+}
+
+static bool readUInt(const std::vector<uint8_t>& data, size_t& pos, uint64_t& val)
+{
+	val = 0;
+	for (unsigned shift = 0; shift < 64; shift += 7)
+	{
+		if (pos >= data.size())
+		{
+			return false;
+		}
+		auto byte = data[pos++];
+		val |= (uint64_t)(byte & 0x7F) << shift;
+		if ((byte & 0x80) == 0)
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+static bool readInt(const std::vector<uint8_t>& data, size_t& pos, int64_t& val)
+{
+	uint64_t uval;
+	if (readUInt(data, pos, uval) == false)
+	{
+		return false;
+	}
+	val = (int64_t)(uval >> 1) ^ -(int64_t)(uval & 1);
+	return true;
+}
+
+static bool readFloat(const std::vector<uint8_t>& data, size_t& pos, float& val)
+{
+	uint64_t bits;
+	if (readUInt(data, pos, bits) == false)
+	{
+		return false;
+	}
+	auto bits32 = (uint32_t)bits;
+	std::memcpy(&val, &bits32, sizeof(val));
+	return true;
+}
+
+InputRecorder::InputRecorder(const std::string& filePath, uint32_t seed_)
+	: file(filePath, std::ios::binary | std::ios::trunc), seed(seed_) {}
+
+InputRecorder::~InputRecorder()
+{
+	if (file.is_open() == true)
+	{
+		writeHeader();
+		file.flush();
+	}
+}
+
+void InputRecorder::writeHeader()
+{
+	if (headerWritten == true)
+	{
+		return;
+	}
+	headerWritten = true;
+	file.write(recordingMagic, sizeof(recordingMagic));
+	buffer.clear();
+	buffer.push_back(recordingVersion);
+	writeUInt(buffer, seed);
+	writeInt(buffer, mousePosition.x);
+	writeInt(buffer, mousePosition.y);
+	writeUInt(buffer, windowSize.x);
+	writeUInt(buffer, windowSize.y);
+	file.write((const char*)buffer.data(), buffer.size());
+}
+
+bool InputRecorder::addEvent(const sf::Event& evt)
+{
+	switch (evt.type)
+	{
+	case sf::Event::Closed:
+	case sf::Event::Resized:
+	case sf::Event::LostFocus:
+	case sf::Event::GainedFocus:
+	case sf::Event::TextEntered:
+	case sf::Event::KeyPressed:
+	case sf::Event::MouseWheelScrolled:
+	case sf::Event::MouseButtonPressed:
+	case sf::Event::MouseButtonReleased:
+	case sf::Event::MouseMoved:
+	case sf::Event::TouchBegan:
+	case sf::Event::TouchMoved:
+	case sf::Event::TouchEnded:
+		events.push_back(evt);
+		return true;
+	default:
+		return false;
+	}
+}
+
+void InputRecorder::addMousePosition(const sf::Vector2i& position)
+{
+	sf::Event evt;
+	std::memset(&evt, 0, sizeof(evt));
+	evt.type = sf::Event::Count;
+	evt.mouseMove.x = position.x;
+	evt.mouseMove.y = position.y;
+	events.push_back(evt);
+}
+
+void InputRecorder::addFrame(const sf::Time& elapsedTime)
+{
+	if (file.is_open() == false)
+	{
+		events.clear();
+		return;
+	}
+	writeHeader();
+	buffer.clear();
+	writeUInt(buffer, (uint64_t)elapsedTime.asMicroseconds());
+	writeUInt(buffer, events.size());
+	for (const auto& evt : events)
+	{
+		buffer.push_back((uint8_t)evt.type);
+		switch (evt.type)
+		{
+		case sf::Event::Resized:
+			writeUInt(buffer, evt.size.width);
+			writeUInt(buffer, evt.size.height);
+			break;
+		case sf::Event::TextEntered:
+			writeUInt(buffer, evt.text.unicode);
+			break;
+		case sf::Event::KeyPressed:
+			writeInt(buffer, evt.key.code);
+			buffer.push_back((uint8_t)(
+				(evt.key.alt ? 1 : 0) |
+				(evt.key.control ? 2 : 0) |
+				(evt.key.shift ? 4 : 0) |
+				(evt.key.system ? 8 : 0)));
+			break;
+		case sf::Event::MouseWheelScrolled:
+			writeUInt(buffer, evt.mouseWheelScroll.wheel);
+			writeFloat(buffer, evt.mouseWheelScroll.delta);
+			writeInt(buffer, evt.mouseWheelScroll.x);
+			writeInt(buffer, evt.mouseWheelScroll.y);
+			break;
+		case sf::Event::MouseButtonPressed:
+		case sf::Event::MouseButtonReleased:
+			writeUInt(buffer, evt.mouseButton.button);
+			writeInt(buffer, evt.mouseButton.x);
+			writeInt(buffer, evt.mouseButton.y);
+			break;
+		case sf::Event::MouseMoved:
+		case sf::Event::Count:
+			writeInt(buffer, evt.mouseMove.x);
+			writeInt(buffer, evt.mouseMove.y);
+			break;
+		case sf::Event::TouchBegan:
+		case sf::Event::TouchMoved:
+		case sf::Event::TouchEnded:
+			writeUInt(buffer, evt.touch.finger);
+			writeInt(buffer, evt.touch.x);
+			writeInt(buffer, evt.touch.y);
+			break;
+		default:
+			break;
+		}
+	}
+	file.write((const char*)buffer.data(), buffer.size());
+	events.clear();
+}
+
+InputReplay::InputReplay(const std::string& filePath)
+{
+	std::ifstream file(filePath, std::ios::binary);
+	if (file.is_open() == false)
+	{
+		return;
+	}
+	data.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+	if (data.size() < sizeof(recordingMagic) + 1 ||
+		std::memcmp(data.data(), recordingMagic, sizeof(recordingMagic)) != 0 ||
+		data[sizeof(recordingMagic)] != recordingVersion)
+	{
+		return;
+	}
+	pos = sizeof(recordingMagic) + 1;
+	uint64_t seed_, width, height;
+	int64_t x, y;
+	if (readUInt(data, pos, seed_) == false ||
+		readInt(data, pos, x) == false ||
+		readInt(data, pos, y) == false ||
+		readUInt(data, pos, width) == false ||
+		readUInt(data, pos, height) == false)
+	{
+		return;
+	}
+	seed = (uint32_t)seed_;
+	mousePosition = sf::Vector2i((int)x, (int)y);
+	windowSize = sf::Vector2u((unsigned)width, (unsigned)height);
+	valid = true;
+}
+
+bool InputReplay::nextFrame()
+{
+	events.clear();
+	uint64_t elapsed, numEvents;
+	if (valid == false ||
+		readUInt(data, pos, elapsed) == false ||
+		readUInt(data, pos, numEvents) == false)
+	{
+		valid = false;
+		return false;
+	}
+	elapsedTime = sf::microseconds((sf::Int64)elapsed);
+	for (uint64_t i = 0; i < numEvents; i++)
+	{
+		if (pos >= data.size())
+		{
+			valid = false;
+			return false;
+		}
+		sf::Event evt;
+		std::memset(&evt, 0, sizeof(evt));
+		evt.type = (sf::Event::EventType)data[pos++];
+		uint64_t uval = 0, uval2 = 0;
+		int64_t x = 0, y = 0;
+		auto ok = true;
+		switch (evt.type)
+		{
+		case sf::Event::Resized:
+			ok = readUInt(data, pos, uval) &&
+				readUInt(data, pos, uval2);
+			evt.size.width = (unsigned)uval;
+			evt.size.height = (unsigned)uval2;
+			break;
+		case sf::Event::TextEntered:
+			ok = readUInt(data, pos, uval);
+			evt.text.unicode = (sf::Uint32)uval;
+			break;
+		case sf::Event::KeyPressed:
+			ok = readInt(data, pos, x) && pos < data.size();
+			if (ok == true)
+			{
+				auto flags = data[pos++];
+				evt.key.code = (sf::Keyboard::Key)x;
+				evt.key.alt = (flags & 1) != 0;
+				evt.key.control = (flags & 2) != 0;
+				evt.key.shift = (flags & 4) != 0;
+				evt.key.system = (flags & 8) != 0;
+			}
+			break;
+		case sf::Event::MouseWheelScrolled:
+			ok = readUInt(data, pos, uval) &&
+				readFloat(data, pos, evt.mouseWheelScroll.delta) &&
+				readInt(data, pos, x) &&
+				readInt(data, pos, y);
+			evt.mouseWheelScroll.wheel = (sf::Mouse::Wheel)uval;
+			evt.mouseWheelScroll.x = (int)x;
+			evt.mouseWheelScroll.y = (int)y;
+			break;
+		case sf::Event::MouseButtonPressed:
+		case sf::Event::MouseButtonReleased:
+			ok = readUInt(data, pos, uval) &&
+				readInt(data, pos, x) &&
+				readInt(data, pos, y);
+			evt.mouseButton.button = (sf::Mouse::Button)uval;
+			evt.mouseButton.x = (int)x;
+			evt.mouseButton.y = (int)y;
+			break;
+		case sf::Event::MouseMoved:
+		case sf::Event::Count:
+			ok = readInt(data, pos, x) &&
+				readInt(data, pos, y);
+			evt.mouseMove.x = (int)x;
+			evt.mouseMove.y = (int)y;
+			break;
+		case sf::Event::TouchBegan:
+		case sf::Event::TouchMoved:
+		case sf::Event::TouchEnded:
+			ok = readUInt(data, pos, uval) &&
+				readInt(data, pos, x) &&
+				readInt(data, pos, y);
+			evt.touch.finger = (unsigned)uval;
+			evt.touch.x = (int)x;
+			evt.touch.y = (int)y;
+			break;
+		default:
+			break;
+		}
+		if (ok == false)
+		{
+			valid = false;
+			return false;
+		}
+		events.push_back(evt);
+	}
+	frame++;
+	return true;
+}
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <cstdint>
+#include <fstream>
+#include <SFML/Window/Event.hpp>
+#include <SFML/System/Time.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <string>
+#include <vector>
+
+// Input recordings store the random seed, the mouse position and window
+// size when the game starts and, for every frame, its elapsed time and the
+// window events that Game::processEvents handles (input, focus, resize and
+// close events). Mouse and touch positions are stored in game coordinates
+// (mapped through the window's view when recorded), so replays don't depend
+// on how the window was scaled. Mouse positions that change without an
+// event (when the view changes) are stored as events of type
+// sf::Event::Count. Numbers are stored as variable length integers, so a
+// frame without events takes 2 or 3 bytes.
+
+// Writes the input of every frame to a file.
+class InputRecorder
+{
+private:
+	std::ofstream file;
+	std::vector<uint8_t> buffer;
+	std::vector<sf::Event> events;
+	uint32_t seed{ 0 };
+	sf::Vector2i mousePosition;
+	sf::Vector2u windowSize;
+	bool headerWritten{ false };
+
+	void writeHeader();
+
+public:
+	InputRecorder(const std::string& filePath, uint32_t seed_);
+	~InputRecorder();
+
+	bool isOpen() const { return file.is_open(); }
+
+	void MousePosition(const sf::Vector2i& mousePosition_) { mousePosition = mousePosition_; }
+	void WindowSize(const sf::Vector2u& windowSize_) { windowSize = windowSize_; }
+
+	// returns false if the event isn't recorded (not handled by the game).
+	bool addEvent(const sf::Event& evt);
+
+	// records a mouse position (in game coordinates) set without an event.
+	void addMousePosition(const sf::Vector2i& position);
+
+	// writes the events added since the last frame.
+	void addFrame(const sf::Time& elapsedTime);
+};
+
+// Reads a recording back one frame at a time.
+class InputReplay
+{
+private:
+	std::vector<uint8_t> data;
+	size_t pos{ 0 };
+	uint32_t seed{ 0 };
+	sf::Vector2i mousePosition;
+	sf::Vector2u windowSize;
+	std::vector<sf::Event> events;
+	sf::Time elapsedTime;
+	uint64_t frame{ 0 };
+	bool valid{ false };
+
+public:
+	InputReplay(const std::string& filePath);
+
+	bool isOpen() const { return valid; }
+
+	uint32_t Seed() const { return seed; }
+	const sf::Vector2i& MousePosition() const { return mousePosition; }
+	const sf::Vector2u& WindowSize() const { return windowSize; }
+
+	// reads the next frame. Returns false at the end of the recording.
+	bool nextFrame();
+
+	const std::vector<sf::Event>& Events() const { return events; }
+	const sf::Time& ElapsedTime() const { return elapsedTime; }
+	uint64_t Frame() const { return frame; }
+};
@@ -0,0 +1,293 @@
+#include "JsonBinary.h"
+#include <cstring>
+
+namespace JsonBinary
+{
+	static const char binaryMagic[4] = { 'D', 'G', 'J', 'B' };
+	static const uint8_t binaryVersion = 1;
+
+	enum class Type : uint8_t
+	{
+		Null,
+		False,
+		True,
+		Int64,
+		Uint64,
+		Double,
+		String,
+		Array,
+		Object
+	};
+
+	static void writeUInt(std::vector<uint8_t>& data, uint64_t val)
+	{
+		while (val >= 0x80)
+		{
+			data.push_back((uint8_t)(val | 0x80));
+			val >>= 7;
+		}
+		data.push_back((uint8_t)val);
+	}
+
+	static void writeString(std::vector<uint8_t>& data, const rapidjson::Value& val)
+	{
+		auto size = val.GetStringLength();
+		writeUInt(data, size);
+		auto str = (const uint8_t*)val.GetString();
+		data.insert(data.end(), str, str + size);
+	}
+
+	static void writeValue(std::vector<uint8_t>& data, const rapidjson::Value& val)
+	{
+		switch (val.GetType())
+		{
+		default:
+		case rapidjson::kNullType:
+			data.push_back((uint8_t)Type::Null);
+			break;
+		case rapidjson::kFalseType:
+			data.push_back((uint8_t)Type::False);
+			break;
+		case rapidjson::kTrueType:
+			data.push_back((uint8_t)Type::True);
+			break;
+		case rapidjson::kNumberType:
+		{
+			if (val.IsDouble() == true)
+			{
+				data.push_back((uint8_t)Type::Double);
+				auto num = val.GetDouble();
+				uint8_t bytes[sizeof(num)];
+				std::memcpy(bytes, &num, sizeof(num));
+				data.insert(data.end(), bytes, bytes + sizeof(num));
+			}
+			else if (val.IsInt64() == true)
+			{
+				data.push_back((uint8_t)Type::Int64);
+				auto num = val.GetInt64();
+				writeUInt(data, ((uint64_t)num << 1) ^ (uint64_t)(num >> 63));
+			}
+			else
+			{
+				data.push_back((uint8_t)Type::Uint64);
+				writeUInt(data, val.GetUint64());
+			}
+			break;
+		}
+		case rapidjson::kStringType:
+			data.push_back((uint8_t)Type::String);
+			writeString(data, val);
+			break;
+		case rapidjson::kArrayType:
+		{
+			data.push_back((uint8_t)Type::Array);
+			writeUInt(data, val.Size());
+			for (const auto& elem : val.GetArray())
+			{
+				writeValue(data, elem);
+			}
+			break;
+		}
+		case rapidjson::kObjectType:
+		{
+			data.push_back((uint8_t)Type::Object);
+			writeUInt(data, val.MemberCount());
+			for (auto it = val.MemberBegin(); it != val.MemberEnd(); ++it)
+			{
+				writeString(data, it->name);
+				writeValue(data, it->value);
+			}
+			break;
+		}
+		}
+	}
+
+	void write(const rapidjson::Value& val, std::vector<uint8_t>& data)
+	{
+		data.insert(data.end(), binaryMagic, binaryMagic + sizeof(binaryMagic));
+		data.push_back(binaryVersion);
+		writeValue(data, val);
+	}
+
+	// Feeds the values of the binary form to a document, like a reader
+	// parsing the text would.
+	class Generator
+	{
+	private:
+		const uint8_t* data;
+		size_t size;
+		size_t pos;
+
+		bool readUInt(uint64_t& val)
+		{
+			val = 0;
+			for (unsigned shift = 0; shift < 64; shift += 7)
+			{
+				if (pos >= size)
+				{
+					return false;
+				}
+				auto byte = data[pos++];
+				val |= (uint64_t)(byte & 0x7F) << shift;
+				if ((byte & 0x80) == 0)
+				{
+					return true;
+				}
+			}
+			return false;
+		}
+
+		bool readString(const char*& str, rapidjson::SizeType& length)
+		{
+			uint64_t size_;
+			if (readUInt(size_) == false ||
+				size_ > size - pos)
+			{
+				return false;
+			}
+			str = (const char*)(data + pos);
+			length = (rapidjson::SizeType)size_;
+			pos += (size_t)size_;
+			return true;
+		}
+
+		bool readCount(rapidjson::SizeType& count)
+		{
+			uint64_t count_;
+			// every element takes at least one byte
+			if (readUInt(count_) == false ||
+				count_ > size - pos)
+			{
+				return false;
+			}
+			count = (rapidjson::SizeType)count_;
+			return true;
+		}
+
+		template <typename Handler>
+		bool readValue(Handler& handler)
+		{
+			if (pos >= size)
+			{
+				return false;
+			}
+			switch ((Type)data[pos++])
+			{
+			case Type::Null:
+				return handler.Null();
+			case Type::False:
+				return handler.Bool(false);
+			case Type::True:
+				return handler.Bool(true);
+			case Type::Int64:
+			{
+				uint64_t val;
+				if (readUInt(val) == false)
+				{
+					return false;
+				}
+				return handler.Int64((int64_t)(val >> 1) ^ -(int64_t)(val & 1));
+			}
+			case Type::Uint64:
+			{
+				uint64_t val;
+				if (readUInt(val) == false)
+				{
+					return false;
+				}
+				return handler.Uint64(val);
+			}
+			case Type::Double:
+			{
+				double val;
+				if (sizeof(val) > size - pos)
+				{
+					return false;
+				}
+				std::memcpy(&val, data + pos, sizeof(val));
+				pos += sizeof(val);
+				return handler.Double(val);
+			}
+			case Type::String:
+			{
+				const char* str;
+				rapidjson::SizeType length;
+				if (readString(str, length) == false)
+				{
+					return false;
+				}
+				return handler.String(str, length, true);
+			}
+			case Type::Array:
+			{
+				rapidjson::SizeType count;
+				if (readCount(count) == false ||
+					handler.StartArray() == false)
+				{
+					return false;
+				}
+				for (rapidjson::SizeType i = 0; i < count; i++)
+				{
+					if (readValue(handler) == false)
+					{
+						return false;
+					}
+				}
+				return handler.EndArray(count);
+			}
+			case Type::Object:
+			{
+				rapidjson::SizeType count;
+				if (readCount(count) == false ||
+					handler.StartObject() == false)
+				{
+					return false;
+				}
+				for (rapidjson::SizeType i = 0; i < count; i++)
+				{
+					const char* str;
+					rapidjson::SizeType length;
+					if (readString(str, length) == false ||
+						handler.Key(str, length, true) == false ||
+						readValue(handler) == false)
+					{
+						return false;
+					}
+				}
+				return handler.EndObject(count);
+			}
+			default:
+				return false;
+			}
+		}
+
+	public:
+		Generator(const uint8_t* data_, size_t size_, size_t pos_)
+			: data(data_), size(size_), pos(pos_) {}
+
+		template <typename Handler>
+		bool operator()(Handler& handler)
+		{
+			return readValue(handler) == true && pos == size;
+		}
+	};
+
+	bool read(const uint8_t* data, size_t size, rapidjson::Document& doc)
+	{
+		if (size < sizeof(binaryMagic) + 1 ||
+			std::memcmp(data, binaryMagic, sizeof(binaryMagic)) != 0 ||
+			data[sizeof(binaryMagic)] != binaryVersion)
+		{
+			doc.SetNull();
+			return false;
+		}
+		Generator generator(data, size, sizeof(binaryMagic) + 1);
+		doc.SetNull();
+		doc.Populate(generator);
+		if (doc.IsNull() == true)
+		{
+			return false;
+		}
+		return true;
+	}
+}
@@ -0,0 +1,20 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include "rapidjson/document.h"
+#include <vector>
+
+// Compact binary form of a parsed json document. Values are a type byte
+// followed by their data, with numbers and lengths stored as variable
+// length integers, so loading it back skips the tokenizing, escaping and
+// number parsing of the text.
+namespace JsonBinary
+{
+	// appends the binary form of val (with a header) to data.
+	void write(const rapidjson::Value& val, std::vector<uint8_t>& data);
+
+	// loads a binary form written by write into doc.
+	// returns false (and leaves doc null) if the data is invalid.
+	bool read(const uint8_t* data, size_t size, rapidjson::Document& doc);
+}
@@ -0,0 +1,236 @@
+#include "JsonCache.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include "FileUtils.h"
+#include "JsonBinary.h"
+
+// MurmurHash64A, which hashes 8 bytes at a time
+static uint64_t hashBytes(const char* data, size_t size, uint64_t seed)
+{
+	const uint64_t m = 0xc6a4a7935bd1e995ULL;
+	const int r = 47;
+	uint64_t hash = seed ^ ((uint64_t)size * m);
+	size_t i = 0;
+	for (; i + 8 <= size; i += 8)
+	{
+		uint64_t word;
+		std::memcpy(&word, data + i, 8);
+		word *= m;
+		word ^= word >> r;
+		word *= m;
+		hash ^= word;
+		hash *= m;
+	}
+	if (i < size)
+	{
+		uint64_t word = 0;
+		std::memcpy(&word, data + i, size - i);
+		hash ^= word;
+		hash *= m;
+	}
+	hash ^= hash >> r;
+	hash *= m;
+	hash ^= hash >> r;
+	return hash;
+}
+
+static uint64_t hashText(const std::string& str)
+{
+	return hashBytes(str.data(), str.size(), 0);
+}
+
+static uint64_t hashFile(const std::string& fileName, int64_t modTime)
+{
+	return hashBytes(fileName.data(), fileName.size(), (uint64_t)modTime);
+}
+
+void JsonCache::Enabled(bool enabled_)
+{
+	enabled = enabled_;
+	if (enabled == false)
+	{
+		clear();
+	}
+}
+
+void JsonCache::clear()
+{
+	entries.clear();
+	entryOrder.clear();
+	size = 0;
+}
+
+std::string JsonCache::getFilePath(uint64_t hash, size_t textSize) const
+{
+	char fileName[32];
+	std::snprintf(fileName, sizeof(fileName), "/%016llx%08x.bin",
+		(unsigned long long)hash, (unsigned)textSize);
+	return dir + fileName;
+}
+
+const JsonCache::Entry* JsonCache::getEntry(uint64_t hash, size_t textSize, bool persist)
+{
+	auto it = entries.find(hash);
+	if (it != entries.end())
+	{
+		if (it->second.textSize == textSize)
+		{
+			return &it->second;
+		}
+		return nullptr;
+	}
+	if (persist == false ||
+		dir.empty() == true ||
+		FileUtils::getSaveDir() == nullptr)
+	{
+		return nullptr;
+	}
+	Entry entry;
+	entry.textSize = textSize;
+	entry.data = FileUtils::readChar(getFilePath(hash, textSize).c_str());
+	if (entry.data.empty() == true)
+	{
+		return nullptr;
+	}
+	addEntry(hash, std::move(entry));
+	it = entries.find(hash);
+	if (it != entries.end())
+	{
+		return &it->second;
+	}
+	return nullptr;
+}
+
+void JsonCache::addEntry(uint64_t hash, Entry&& entry)
+{
+	auto it = entries.find(hash);
+	if (it != entries.end())
+	{
+		size -= it->second.data.size();
+		entries.erase(it);
+		entryOrder.erase(std::find(entryOrder.begin(), entryOrder.end(), hash));
+	}
+	if (entry.data.size() > maxSize)
+	{
+		return;
+	}
+	// the oldest entries are removed first
+	while (size + entry.data.size() > maxSize && entryOrder.empty() == false)
+	{
+		it = entries.find(entryOrder.front());
+		if (it != entries.end())
+		{
+			size -= it->second.data.size();
+			entries.erase(it);
+		}
+		entryOrder.pop_front();
+	}
+	size += entry.data.size();
+	entries.insert(std::make_pair(hash, std::move(entry)));
+	entryOrder.push_back(hash);
+}
+
+void JsonCache::addStats(const std::string& fileName, bool loaded, int64_t startTime)
+{
+	if (fileName.empty() == true)
+	{
+		return;
+	}
+	auto& fileStats = stats[fileName];
+	auto time = clock.getElapsedTime().asMicroseconds() - startTime;
+	if (loaded == true)
+	{
+		fileStats.loads++;
+		fileStats.loadTime += time;
+	}
+	else
+	{
+		fileStats.parses++;
+		fileStats.parseTime += time;
+	}
+}
+
+bool JsonCache::load(const std::string& fileName, uint64_t hash, size_t textSize,
+	bool persist, rapidjson::Document& doc, int64_t startTime)
+{
+	auto entry = getEntry(hash, textSize, persist);
+	if (entry != nullptr &&
+		JsonBinary::read(entry->data.data(), entry->data.size(), doc) == true)
+	{
+		addStats(fileName, true, startTime);
+		return true;
+	}
+	return false;
+}
+
+bool JsonCache::parse(const std::string& fileName, uint64_t hash, std::string& json,
+	rapidjson::Document& doc, bool persist, int64_t startTime)
+{
+	if (json.empty() == true)
+	{
+		return false;
+	}
+	auto textSize = json.size();
+	auto hasError = doc.ParseInsitu(&json[0]).HasParseError();
+	if (hasError == false && enabled == true)
+	{
+		Entry entry;
+		entry.textSize = textSize;
+		JsonBinary::write(doc, entry.data);
+		if (persist == true &&
+			dir.empty() == false &&
+			FileUtils::getSaveDir() != nullptr)
+		{
+			FileUtils::createDir(dir.c_str());
+			FileUtils::saveText(getFilePath(hash, entry.textSize).c_str(),
+				(const char*)entry.data.data(), entry.data.size());
+		}
+		addEntry(hash, std::move(entry));
+	}
+	addStats(fileName, false, startTime);
+	return hasError == false;
+}
+
+bool JsonCache::parse(const std::string& fileName, std::string& json,
+	rapidjson::Document& doc, bool persist)
+{
+	auto startTime = clock.getElapsedTime().asMicroseconds();
+	uint64_t hash = 0;
+	if (enabled == true)
+	{
+		hash = hashText(json);
+		if (load(fileName, hash, json.size(), persist, doc, startTime) == true)
+		{
+			return true;
+		}
+	}
+	return parse(fileName, hash, json, doc, persist, startTime);
+}
+
+bool JsonCache::parseFile(const std::string& fileName, std::string& json,
+	rapidjson::Document& doc)
+{
+	auto startTime = clock.getElapsedTime().asMicroseconds();
+	uint64_t fileSize = 0;
+	int64_t modTime = 0;
+	if (enabled == false ||
+		FileUtils::getFileStats(fileName.c_str(), fileSize, modTime) == false)
+	{
+		if (FileUtils::readText(fileName.c_str(), json) == false)
+		{
+			return false;
+		}
+		return parse(fileName, json, doc, false);
+	}
+	auto hash = hashFile(fileName, modTime);
+	if (load(fileName, hash, (size_t)fileSize, true, doc, startTime) == true)
+	{
+		return true;
+	}
+	if (FileUtils::readText(fileName.c_str(), json) == false)
+	{
+		return false;
+	}
+	return parse(fileName, hash, json, doc, true, startTime);
+}
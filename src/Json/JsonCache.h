@@ -0,0 +1,86 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include "rapidjson/document.h"
+#include <SFML/System/Clock.hpp>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+struct JsonCacheFileStats
+{
+	// text parses (not in the cache) and loads of the binary form
+	uint32_t parses{ 0 };
+	uint32_t loads{ 0 };
+	// in microseconds
+	int64_t parseTime{ 0 };
+	int64_t loadTime{ 0 };
+};
+
+// Keeps the binary form (JsonBinary) of the parsed json files, so files
+// that are loaded again (or with the same parameters) skip the text parsing.
+// Game files are keyed by their path, size and modification time, so a
+// cached one isn't read at all. Texts (files loaded with parameters and
+// saved games) are keyed by a hash of the text. The binary forms are kept
+// in memory (up to maxSize bytes) and, if a dir is set, saved in the save
+// dir to be used in the next runs.
+class JsonCache
+{
+private:
+	struct Entry
+	{
+		size_t textSize{ 0 };
+		std::vector<uint8_t> data;
+	};
+
+	std::unordered_map<uint64_t, Entry> entries;
+	std::deque<uint64_t> entryOrder;
+	size_t size{ 0 };
+	size_t maxSize{ 16 * 1024 * 1024 };
+	std::string dir;
+	bool enabled{ true };
+	std::map<std::string, JsonCacheFileStats> stats;
+	sf::Clock clock;
+
+	std::string getFilePath(uint64_t hash, size_t textSize) const;
+	const Entry* getEntry(uint64_t hash, size_t textSize, bool persist);
+	void addEntry(uint64_t hash, Entry&& entry);
+	void addStats(const std::string& fileName, bool loaded, int64_t startTime);
+
+	bool load(const std::string& fileName, uint64_t hash, size_t textSize,
+		bool persist, rapidjson::Document& doc, int64_t startTime);
+	bool parse(const std::string& fileName, uint64_t hash, std::string& json,
+		rapidjson::Document& doc, bool persist, int64_t startTime);
+
+public:
+	bool Enabled() const { return enabled; }
+	const std::string& Dir() const { return dir; }
+	size_t MaxSize() const { return maxSize; }
+	const std::map<std::string, JsonCacheFileStats>& Stats() const { return stats; }
+
+	void Enabled(bool enabled_);
+	// dir (in the save dir) for the binary forms. empty to only use memory.
+	void Dir(const std::string& dir_) { dir = dir_; }
+	void MaxSize(size_t maxSize_) { maxSize = maxSize_; }
+
+	// removes the binary forms kept in memory.
+	void clear();
+
+	// parses json into doc, loading its binary form if it's cached.
+	// json is parsed in place, so it must live as long as doc.
+	// fileName is used for the stats. persist saves the binary form on disk.
+	// returns false if json isn't valid.
+	bool parse(const std::string& fileName, std::string& json,
+		rapidjson::Document& doc, bool persist);
+
+	// reads and parses the game file fileName into json and doc, unless its
+	// binary form is cached. Only for files that don't change while the game
+	// runs (not saved games), since times only have a one second resolution.
+	// the binary form is saved on disk. returns false if the file can't be
+	// read or isn't valid.
+	bool parseFile(const std::string& fileName, std::string& json,
+		rapidjson::Document& doc);
+};
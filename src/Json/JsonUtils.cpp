@@ -1,6 +1,7 @@
 #include "JsonUtils.h"
 #include "Game.h"
-#include <regex>
+#include "JsonBinary.h"
+#include "TextTemplate.h"
 #include "Utils.h"
 
 namespace JsonUtils
@@ -29,7 +30,40 @@ namespace JsonUtils
 		}
 	}
 
-	std::regex regexPercent(R"((\%[\w.]+\%))");
+	// replaces the %placeholders% in a string value. If the string is only
+	// one placeholder and changeValueType is true, the value takes the type
+	// of the variable.
+	template <class GetValue>
+	void replaceStringWithTemplate(Value& elem, Value::AllocatorType& allocator,
+		bool allowDots, bool changeValueType, GetValue getValue)
+	{
+		if (TextTemplate::mayHavePlaceholders(elem.GetString()) == false)
+		{
+			return;
+		}
+		TextTemplate strTemplate(elem.GetString(), allowDots);
+		if (strTemplate.hasPlaceholders() == false)
+		{
+			return;
+		}
+		if (changeValueType == true &&
+			strTemplate.isPlaceholder() == true)
+		{
+			Variable var;
+			if (getValue(strTemplate.getPlaceholder(0), var) == true)
+			{
+				replaceValueWithVariable(elem, allocator, var);
+			}
+			return;
+		}
+		// reuses its memory between calls
+		static thread_local std::string buffer;
+		buffer.clear();
+		if (strTemplate.render(buffer, getValue) > 0)
+		{
+			elem.SetString(buffer.c_str(), buffer.size(), allocator);
+		}
+	}
 
 	void replaceStringWithVariable(Value& elem,
 		Value::AllocatorType& allocator, const std::string& str,
@@ -65,33 +99,11 @@ namespace JsonUtils
 		{
 			return;
 		}
-		std::string str1(elem.GetString());
-		std::string str2(str1);
-		std::smatch match;
-		bool hadMatch = false;
-		while (std::regex_search(str1, match, regexPercent) == true)
-		{
-			hadMatch = true;
-			auto strProp = match[1].str();
-			Variable var;
-			if (obj.getProperty(strProp.substr(1, strProp.size() - 2), var) == true)
+		replaceStringWithTemplate(elem, allocator, true, changeValueType,
+			[&obj](const std::string& prop, Variable& var)
 			{
-				if (changeValueType == true &&
-					strProp == str2)
-				{
-					replaceValueWithVariable(elem, allocator, var);
-					return;
-				}
-				Utils::replaceStringInPlace(
-					str2, strProp, VarUtils::toString(var));
-			}
-			str1 = match.suffix().str();
-		}
-		if (hadMatch == true &&
-			elem.GetString() != str2)
-		{
-			elem.SetString(str2.c_str(), str2.size(), allocator);
-		}
+				return obj.getProperty(prop, var);
+			});
 	}
 
 	void replaceValueWithString(Value& elem, Value::AllocatorType& allocator,
@@ -151,41 +163,17 @@ namespace JsonUtils
 		}
 	}
 
-	std::regex regexPercent2(R"((\%\w+\%))");
-
 	void replaceValueWithGameVar(Value& elem,
 		Value::AllocatorType& allocator,
 		const Game& game, bool changeValueType)
 	{
 		if (elem.IsString() == true)
 		{
-			std::string str1(elem.GetString());
-			std::string str2(str1);
-			std::smatch match;
-			bool hadMatch = false;
-			while (std::regex_search(str1, match, regexPercent2) == true)
-			{
-				hadMatch = true;
-				auto strProp = match[1].str();
-				Variable var;
-				if (game.getVariable(strProp, var) == true)
+			replaceStringWithTemplate(elem, allocator, false, changeValueType,
+				[&game](const std::string& name, Variable& var)
 				{
-					if (changeValueType == true &&
-						strProp == str2)
-					{
-						replaceValueWithVariable(elem, allocator, var);
-						return;
-					}
-					Utils::replaceStringInPlace(
-						str2, strProp, VarUtils::toString(var));
-				}
-				str1 = match.suffix().str();
-			}
-			if (hadMatch == true &&
-				elem.GetString() != str2)
-			{
-				elem.SetString(str2.c_str(), str2.size(), allocator);
-			}
+					return game.getVariableNoPercentage(name, var);
+				});
 		}
 		else if (elem.IsObject() == true)
 		{
@@ -251,4 +239,11 @@ namespace JsonUtils
 	{
 		FileUtils::saveText(file.c_str(), jsonToString(elem));
 	}
+
+	void copyToDocument(const Value& elem, Document& doc)
+	{
+		std::vector<uint8_t> data;
+		JsonBinary::write(elem, data);
+		JsonBinary::read(data.data(), data.size(), doc);
+	}
 }
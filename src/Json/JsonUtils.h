@@ -42,6 +42,10 @@ namespace JsonUtils
 
 	void saveToFile(const std::string& file, const rapidjson::Value& elem);
 
+	// copies elem into doc with all its strings. CopyFrom only copies the
+	// pointers of strings parsed in place, which point into the parsed text.
+	void copyToDocument(const rapidjson::Value& elem, rapidjson::Document& doc);
+
 	template <class T>
 	void saveToFile(const std::string& file, const char* key, const T& container)
 	{
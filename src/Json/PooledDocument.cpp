@@ -0,0 +1,77 @@
+#include "PooledDocument.h"
+#include <algorithm>
+#include <vector>
+
+// the allocator's first chunk grows to the size used by the biggest
+// document, up to this size, so the next documents don't allocate.
+static const size_t minChunkSize = 64 * 1024;
+static const size_t maxChunkSize = 1024 * 1024;
+static const size_t maxTextSize = 1024 * 1024;
+static const size_t maxPoolSize = 16;
+
+struct PooledDocument::Buffers
+{
+	std::string text;
+	std::vector<char> chunk;
+	std::unique_ptr<rapidjson::MemoryPoolAllocator<>> allocator;
+	std::unique_ptr<rapidjson::Document> doc;
+
+	void create(size_t chunkSize)
+	{
+		doc.reset();
+		allocator.reset();
+		std::vector<char>(chunkSize).swap(chunk);
+		allocator = std::make_unique<rapidjson::MemoryPoolAllocator<>>(
+			chunk.data(), chunk.size());
+		doc = std::make_unique<rapidjson::Document>(allocator.get());
+	}
+
+	void clear()
+	{
+		doc->SetNull();
+		text.clear();
+		if (text.capacity() > maxTextSize)
+		{
+			text.shrink_to_fit();
+		}
+		auto capacity = allocator->Capacity();
+		if (capacity > chunk.size() && chunk.size() < maxChunkSize)
+		{
+			create(std::min(capacity, maxChunkSize));
+		}
+		else
+		{
+			allocator->Clear();
+		}
+	}
+};
+
+static thread_local std::vector<std::unique_ptr<PooledDocument::Buffers>> pool;
+
+PooledDocument::PooledDocument()
+{
+	if (pool.empty() == false)
+	{
+		buffers = std::move(pool.back());
+		pool.pop_back();
+	}
+	else
+	{
+		buffers = std::make_unique<Buffers>();
+		buffers->create(minChunkSize);
+	}
+}
+
+PooledDocument::~PooledDocument()
+{
+	if (pool.size() >= maxPoolSize)
+	{
+		return;
+	}
+	buffers->clear();
+	pool.push_back(std::move(buffers));
+}
+
+std::string& PooledDocument::Text() { return buffers->text; }
+
+rapidjson::Document& PooledDocument::Doc() { return *buffers->doc; }
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <memory>
+#include "rapidjson/document.h"
+#include <SFML/System/NonCopyable.hpp>
+#include <string>
+
+// A document with its text buffer and allocator, taken from a per thread
+// pool and given back when destroyed, so the files parsed one after the
+// other (or nested, when a file loads others) reuse the same memory.
+// The text is meant to be parsed in place (ParseInsitu), so the document's
+// strings point into the text buffer, which lives as long as the document.
+// The parse stack isn't pooled: rapidjson allocates it with malloc on each
+// parse (1 KB, grown with realloc for big documents) and frees it at the
+// end, since its stack allocator is fixed by the Document type.
+class PooledDocument : public sf::NonCopyable
+{
+public:
+	struct Buffers;
+
+private:
+	std::unique_ptr<Buffers> buffers;
+
+public:
+	PooledDocument();
+	~PooledDocument();
+
+	// empty, but keeps the capacity of the previous texts.
+	std::string& Text();
+	rapidjson::Document& Doc();
+};
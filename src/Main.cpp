@@ -1,5 +1,115 @@
+#include <algorithm>
+#include <cstdlib>
+#include "InputRecorder.h"
 #include <iostream>
+#include <memory>
 #include "Parser/Parser.h"
+#include <random>
+#include <string>
+#include "Utils.h"
+#include <vector>
+
+#ifndef __ANDROID__
+struct Options
+{
+	bool headless{ false };
+	bool draw{ false };
+	double frameTime{ 1000.0 / 60.0 };
+	uint64_t frames{ 0 };
+	double time{ 0.0 };
+	std::string record;
+	std::string replay;
+	bool parseTrace{ false };
+	std::string parseTraceFile;
+};
+
+// splits the command line in options (--name or --name=value) and paths.
+static std::vector<std::string> parseArgs(int argc, char *argv[], Options& options)
+{
+	std::vector<std::string> paths;
+	for (int i = 1; i < argc; i++)
+	{
+		std::string arg(argv[i]);
+		if (arg.size() < 2 || arg.compare(0, 2, "--") != 0)
+		{
+			paths.push_back(arg);
+			continue;
+		}
+		std::string value;
+		auto pos = arg.find('=');
+		if (pos != std::string::npos)
+		{
+			value = arg.substr(pos + 1);
+			arg = arg.substr(0, pos);
+		}
+		if (arg == "--headless")
+		{
+			options.headless = true;
+		}
+		else if (arg == "--draw")
+		{
+			options.draw = true;
+		}
+		else if (arg == "--frametime")
+		{
+			options.frameTime = std::strtod(value.c_str(), nullptr);
+		}
+		else if (arg == "--frames")
+		{
+			options.frames = std::strtoull(value.c_str(), nullptr, 10);
+		}
+		else if (arg == "--time")
+		{
+			options.time = std::strtod(value.c_str(), nullptr);
+		}
+		else if (arg == "--record")
+		{
+			options.record = value;
+		}
+		else if (arg == "--replay")
+		{
+			options.replay = value;
+		}
+		else if (arg == "--parsetrace")
+		{
+			options.parseTrace = true;
+			options.parseTraceFile = value;
+		}
+		else
+		{
+			std::cerr << "unknown option: " << arg << "\n";
+		}
+	}
+	return paths;
+}
+
+static void printFrameStats(const FrameTimeHistogram& frameTimes)
+{
+	if (frameTimes.empty() == true)
+	{
+		return;
+	}
+	auto total = frameTimes.Total();
+	auto percentile = [&frameTimes](double p)
+	{
+		return (double)frameTimes.getPercentile(p) / 1000.0;
+	};
+	auto mean = (double)total / (double)frameTimes.Count() / 1000.0;
+
+	std::cout << "frames: " << frameTimes.Count() << "\n";
+	std::cout << "total (ms): " << (double)total / 1000.0 << "\n";
+	std::cout << "mean (ms): " << mean << "\n";
+	std::cout << "min (ms): " << (double)frameTimes.Min() / 1000.0 << "\n";
+	std::cout << "p50 (ms): " << percentile(50) << "\n";
+	std::cout << "p95 (ms): " << percentile(95) << "\n";
+	std::cout << "p99 (ms): " << percentile(99) << "\n";
+	std::cout << "max (ms): " << (double)frameTimes.Max() / 1000.0 << "\n";
+	if (total > 0)
+	{
+		std::cout << "fps: " << (double)frameTimes.Count() * 1000000.0 / (double)total << "\n";
+	}
+}
+#endif
 
 int main(int argc, char *argv[])
 {
@@ -13,13 +123,64 @@ int main(int argc, char *argv[])
 #ifdef __ANDROID__
 		Parser::parseGame(game, "/sdcard/gamefiles.zip", "main.json");
 #else
-		if (argc == 2)
+		// usage: DGEngine [path [mainFile]] [--headless [--draw]
+		//   [--frametime=ms] [--frames=n] [--time=seconds]]
+		//   [--record=file | --replay=file] [--parsetrace[=file]]
+		// recording and replaying turn off the path finder thread and
+		// parallel loading, so the replays match the recordings.
+		Options options;
+		auto paths = parseArgs(argc, argv, options);
+
+		// traces the parsed elements from the start. Saved as a Chrome trace
+		// if there's a file, else printed as a summary when the game ends.
+		// the allocated bytes are 0 unless built with
+		// DGENGINE_PARSE_TRACER_ALLOCATIONS.
+		game.getParseTracer().Enabled(options.parseTrace);
+
+		// the seed is set before parsing, which can run actions
+		if (options.replay.empty() == false)
 		{
-			Parser::parseGame(game, argv[1], "main.json");
+			auto replay = std::make_unique<InputReplay>(options.replay);
+			if (replay->isOpen() == true)
+			{
+				Utils::Random::seed(replay->Seed());
+				game.setInputReplay(std::move(replay));
+			}
+			else
+			{
+				std::cerr << "invalid input recording: " << options.replay << "\n";
+			}
 		}
-		else if (argc == 3)
+		else if (options.record.empty() == false)
 		{
-			Parser::parseGame(game, argv[1], argv[2]);
+			auto seed = std::random_device()();
+			auto recorder = std::make_unique<InputRecorder>(options.record, seed);
+			if (recorder->isOpen() == true)
+			{
+				Utils::Random::seed(seed);
+				game.setInputRecorder(std::move(recorder));
+			}
+			else
+			{
+				std::cerr << "can't write input recording: " << options.record << "\n";
+			}
+		}
+
+		if (options.headless == true)
+		{
+			game.setHeadless(options.draw,
+				sf::microseconds((sf::Int64)(options.frameTime * 1000.0)),
+				options.frames,
+				sf::microseconds((sf::Int64)(options.time * 1000000.0)));
+		}
+
+		if (paths.size() == 1)
+		{
+			Parser::parseGame(game, paths[0], "main.json");
+		}
+		else if (paths.size() >= 2)
+		{
+			Parser::parseGame(game, paths[0], paths[1]);
 		}
 		else
 		{
@@ -27,6 +188,38 @@ int main(int argc, char *argv[])
 		}
 #endif
 		game.play();
+
+#ifndef __ANDROID__
+		if (options.parseTrace == true)
+		{
+			if (options.parseTraceFile.empty() == false)
+			{
+				if (game.getParseTracer().saveTrace(options.parseTraceFile) == false)
+				{
+					std::cerr << "can't write parse trace: " << options.parseTraceFile << "\n";
+				}
+			}
+			else
+			{
+				game.getParseTracer().printSummary(std::cout);
+			}
+		}
+		if (game.isHeadless() == true)
+		{
+			printFrameStats(game.getFrameTimes());
+			const auto& bindingStats = game.getTextBindingStats();
+			std::cout << "text bindings executed: " << bindingStats.executed << "\n";
+			std::cout << "text bindings skipped: " << bindingStats.skipped << "\n";
+			for (const auto& fileStats : game.getJsonCache().Stats())
+			{
+				std::cout << "json " << fileStats.first
+					<< ": parsed " << fileStats.second.parses
+					<< " (" << (double)fileStats.second.parseTime / 1000.0 << " ms)"
+					<< ", cached " << fileStats.second.loads
+					<< " (" << (double)fileStats.second.loadTime / 1000.0 << " ms)\n";
+			}
+		}
+#endif
 	}
 	catch (std::exception ex)
 	{
@@ -0,0 +1,285 @@
+#include "ParseTracer.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <new>
+#include "PhysFSStream.h"
+#include "rapidjson/stringbuffer.h"
+#include "rapidjson/writer.h"
+
+#ifdef USE_PARSE_TRACER_ALLOCATIONS
+#include <atomic>
+
+// counts the bytes allocated with new
+static std::atomic<uint64_t> bytesAllocated{ 0 };
+
+void* operator new(std::size_t size)
+{
+	bytesAllocated.fetch_add(size, std::memory_order_relaxed);
+	auto ptr = std::malloc(size == 0 ? 1 : size);
+	if (ptr == nullptr)
+	{
+		throw std::bad_alloc();
+	}
+	return ptr;
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+	bytesAllocated.fetch_add(size, std::memory_order_relaxed);
+	return std::malloc(size == 0 ? 1 : size);
+}
+
+void operator delete(void* ptr) noexcept
+{
+	std::free(ptr);
+}
+
+void operator delete(void* ptr, const std::nothrow_t&) noexcept
+{
+	std::free(ptr);
+}
+
+uint64_t ParseTracer::getBytesAllocated()
+{
+	return bytesAllocated.load(std::memory_order_relaxed);
+}
+#else
+uint64_t ParseTracer::getBytesAllocated() { return 0; }
+#endif
+
+void ParseTracer::Enabled(bool enable)
+{
+	if (enabled == enable)
+	{
+		return;
+	}
+	enabled = enable;
+	if (enable == true)
+	{
+		clear();
+	}
+	else
+	{
+		// the spans are kept until enabled again
+		openSpans.clear();
+	}
+}
+
+void ParseTracer::clear()
+{
+	spans.clear();
+	openSpans.clear();
+	files.clear();
+	fileIndexes.clear();
+	clock.restart();
+}
+
+void ParseTracer::setTypeName(uint16_t type, const char* name)
+{
+	if (typeNames.find(type) == typeNames.end())
+	{
+		typeNames[type] = name;
+	}
+}
+
+void ParseTracer::begin(Span&& span)
+{
+	if (span.isFile == false && openSpans.empty() == false)
+	{
+		// elements are in the file of their parent
+		span.file = spans[openSpans.back().span].file;
+	}
+	openSpans.push_back({ spans.size(), 0, 0, 0 });
+	spans.push_back(std::move(span));
+	// read after adding the span, so it doesn't count its own allocations
+	auto& newSpan = spans.back();
+	newSpan.start = clock.getElapsedTime().asMicroseconds();
+	newSpan.bytesRead = sf::PhysFSStream::getBytesRead();
+	newSpan.bytesAllocated = getBytesAllocated();
+}
+
+void ParseTracer::beginFile(const std::string& fileName)
+{
+	uint32_t fileIdx;
+	auto it = fileIndexes.find(fileName);
+	if (it != fileIndexes.end())
+	{
+		fileIdx = it->second;
+	}
+	else
+	{
+		fileIdx = (uint32_t)files.size();
+		files.push_back(fileName);
+		fileIndexes[fileName] = fileIdx;
+	}
+	Span span;
+	span.isFile = true;
+	span.file = fileIdx;
+	begin(std::move(span));
+}
+
+void ParseTracer::beginElement(uint16_t type)
+{
+	Span span;
+	span.type = type;
+	begin(std::move(span));
+}
+
+void ParseTracer::end()
+{
+	if (openSpans.empty() == true)
+	{
+		return;
+	}
+	auto openSpan = openSpans.back();
+	openSpans.pop_back();
+
+	auto& span = spans[openSpan.span];
+	span.duration = clock.getElapsedTime().asMicroseconds() - span.start;
+	span.bytesRead = sf::PhysFSStream::getBytesRead() - span.bytesRead;
+	span.bytesAllocated = getBytesAllocated() - span.bytesAllocated;
+	span.selfDuration = span.duration - openSpan.childDuration;
+	span.selfBytesRead = span.bytesRead - openSpan.childBytesRead;
+	span.selfBytesAllocated = span.bytesAllocated - openSpan.childBytesAllocated;
+
+	if (openSpans.empty() == false)
+	{
+		auto& parent = openSpans.back();
+		parent.childDuration += span.duration;
+		parent.childBytesRead += span.bytesRead;
+		parent.childBytesAllocated += span.bytesAllocated;
+	}
+}
+
+const std::string& ParseTracer::getName(const Span& span) const
+{
+	static const std::string unknown("unknown");
+	if (span.isFile == true)
+	{
+		return files[span.file];
+	}
+	auto it = typeNames.find(span.type);
+	if (it != typeNames.end())
+	{
+		return it->second;
+	}
+	return unknown;
+}
+
+bool ParseTracer::saveTrace(const std::string& filePath) const
+{
+	rapidjson::StringBuffer buffer;
+	rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+	writer.StartObject();
+	writer.Key("traceEvents");
+	writer.StartArray();
+	for (const auto& span : spans)
+	{
+		writer.StartObject();
+		writer.Key("name");
+		writer.String(getName(span).c_str());
+		writer.Key("cat");
+		writer.String(span.isFile == true ? "file" : "element");
+		writer.Key("ph");
+		writer.String("X");
+		writer.Key("ts");
+		writer.Int64(span.start);
+		writer.Key("dur");
+		writer.Int64(span.duration);
+		writer.Key("pid");
+		writer.Int(1);
+		writer.Key("tid");
+		writer.Int(1);
+		writer.Key("args");
+		writer.StartObject();
+		if (span.file != noFile)
+		{
+			writer.Key("file");
+			writer.String(files[span.file].c_str());
+		}
+		writer.Key("bytesRead");
+		writer.Uint64(span.bytesRead);
+		writer.Key("bytesAllocated");
+		writer.Uint64(span.bytesAllocated);
+		writer.EndObject();
+		writer.EndObject();
+	}
+	writer.EndArray();
+	writer.Key("displayTimeUnit");
+	writer.String("ms");
+	writer.EndObject();
+
+	std::ofstream file(filePath, std::ios::binary | std::ios::trunc);
+	if (file.is_open() == false)
+	{
+		return false;
+	}
+	file.write(buffer.GetString(), buffer.GetSize());
+	return file.good();
+}
+
+void ParseTracer::printSummary(std::ostream& out) const
+{
+	struct Totals
+	{
+		std::string name;
+		std::string file;
+		size_t count{ 0 };
+		sf::Int64 duration{ 0 };
+		sf::Int64 selfDuration{ 0 };
+		uint64_t selfBytesRead{ 0 };
+		uint64_t selfBytesAllocated{ 0 };
+	};
+
+	// the spans of an element type in a file are added up. Nested spans of
+	// the same type (a load inside a loaded file) count their time twice in
+	// the total, but not in the self time.
+	std::map<std::pair<uint32_t, std::pair<bool, uint16_t>>, Totals> totals;
+	for (const auto& span : spans)
+	{
+		auto& total = totals[std::make_pair(span.file, std::make_pair(span.isFile, span.type))];
+		if (total.count == 0)
+		{
+			total.name = span.isFile == true ? "(file)" : getName(span);
+			if (span.file != noFile)
+			{
+				total.file = files[span.file];
+			}
+		}
+		total.count++;
+		total.duration += span.duration;
+		total.selfDuration += span.selfDuration;
+		total.selfBytesRead += span.selfBytesRead;
+		total.selfBytesAllocated += span.selfBytesAllocated;
+	}
+
+	std::vector<const Totals*> sorted;
+	for (const auto& total : totals)
+	{
+		sorted.push_back(&total.second);
+	}
+	std::sort(sorted.begin(), sorted.end(), [](const Totals* a, const Totals* b)
+	{
+		return a->selfDuration > b->selfDuration;
+	});
+
+	char line[256];
+	std::snprintf(line, sizeof(line), "%10s %10s %6s %10s %10s  %-20s %s\n",
+		"self (ms)", "total (ms)", "count", "read (KB)", "alloc (KB)", "element", "file");
+	out << line;
+	for (const auto& total : sorted)
+	{
+		std::snprintf(line, sizeof(line), "%10.3f %10.3f %6u %10.1f %10.1f  %-20s %s\n",
+			(double)total->selfDuration / 1000.0,
+			(double)total->duration / 1000.0,
+			(unsigned)total->count,
+			(double)total->selfBytesRead / 1024.0,
+			(double)total->selfBytesAllocated / 1024.0,
+			total->name.c_str(),
+			total->file.c_str());
+		out << line;
+	}
+}
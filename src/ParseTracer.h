@@ -0,0 +1,112 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <SFML/System/Clock.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Records a span for each parsed file and document element, with its
+// wall time, the bytes read through PhysFS and the bytes allocated, to
+// find which elements make loading slow. Spans nest, so the elements of a
+// loaded file are children of the load element (or action) that loaded it.
+// The spans can be saved as a Chrome trace (chrome://tracing, Perfetto)
+// or printed as a summary table.
+class ParseTracer
+{
+private:
+	static const uint32_t noFile = (uint32_t)-1;
+
+	struct Span
+	{
+		uint16_t type{ 0 };
+		bool isFile{ false };
+		uint32_t file{ noFile };
+		sf::Int64 start{ 0 };
+		sf::Int64 duration{ 0 };
+		uint64_t bytesRead{ 0 };
+		uint64_t bytesAllocated{ 0 };
+		// without the child spans
+		sf::Int64 selfDuration{ 0 };
+		uint64_t selfBytesRead{ 0 };
+		uint64_t selfBytesAllocated{ 0 };
+	};
+
+	struct OpenSpan
+	{
+		size_t span;
+		sf::Int64 childDuration;
+		uint64_t childBytesRead;
+		uint64_t childBytesAllocated;
+	};
+
+	sf::Clock clock;
+	std::vector<Span> spans;
+	std::vector<OpenSpan> openSpans;
+	std::vector<std::string> files;
+	std::unordered_map<std::string, uint32_t> fileIndexes;
+	std::unordered_map<uint16_t, std::string> typeNames;
+	bool enabled{ false };
+
+	void begin(Span&& span);
+	const std::string& getName(const Span& span) const;
+
+public:
+	bool Enabled() const { return enabled; }
+	// enabling clears the previous spans.
+	void Enabled(bool enable);
+
+	void clear();
+
+	// the name of an element type (str2int16 hash).
+	void setTypeName(uint16_t type, const char* name);
+
+	void beginFile(const std::string& fileName);
+	void beginElement(uint16_t type);
+	void end();
+
+	bool saveTrace(const std::string& filePath) const;
+
+	// totals per element type and file, the slowest first.
+	void printSummary(std::ostream& out) const;
+
+	// bytes allocated by the program so far. Always 0 unless built with
+	// DGENGINE_PARSE_TRACER_ALLOCATIONS.
+	static uint64_t getBytesAllocated();
+};
+
+// Traces the enclosing block as a file or element span if the tracer is enabled.
+class ParseTraceScope : public sf::NonCopyable
+{
+private:
+	ParseTracer& tracer;
+	bool active;
+
+public:
+	ParseTraceScope(ParseTracer& tracer_, const std::string& fileName)
+		: tracer(tracer_), active(tracer_.Enabled())
+	{
+		if (active == true)
+		{
+			tracer.beginFile(fileName);
+		}
+	}
+	ParseTraceScope(ParseTracer& tracer_, uint16_t type, bool trace = true)
+		: tracer(tracer_), active(trace == true && tracer_.Enabled() == true)
+	{
+		if (active == true)
+		{
+			tracer.beginElement(type);
+		}
+	}
+	~ParseTraceScope()
+	{
+		if (active == true)
+		{
+			tracer.end();
+		}
+	}
+};
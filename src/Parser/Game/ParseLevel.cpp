@@ -108,6 +108,10 @@ namespace Parser
 				return;
 			}
 			auto levelPtr = std::make_shared<Level>();
+			if (game.isRecordingOrReplaying() == true)
+			{
+				levelPtr->PathJobs().UseWorker(false);
+			}
 			game.Resources().addDrawable(id, levelPtr);
 			level = levelPtr.get();
 			game.Resources().setCurrentLevel(level);
@@ -123,6 +127,28 @@ namespace Parser
 			parseLevelMap(game, elem, *level);
 		}
 
+		if (elem.HasMember("pathFinder") == true)
+		{
+			auto& map = level->Map();
+			map.setPathFinderMode(GameUtils::getPathFinderMode(
+				getStringVal(elem["pathFinder"]), map.getPathFinderMode()));
+		}
+		level->Map().updatePathFinder();
+
+		if (elem.HasMember("asyncPathFinder") == true)
+		{
+			level->AsyncPathFinder(getBoolVal(elem["asyncPathFinder"]));
+		}
+		if (elem.HasMember("pathFinderThread") == true)
+		{
+			level->PathJobs().UseWorker(getBoolVal(elem["pathFinderThread"]) == true &&
+				game.isRecordingOrReplaying() == false);
+		}
+		if (elem.HasMember("pathFinderBudget") == true)
+		{
+			level->PathJobs().MainThreadBudget(getUIntVal(elem["pathFinderBudget"]));
+		}
+
 		level->Name(getStringKey(elem, "name"));
 
 		if (elem.HasMember("followCurrentPlayer") == true)
@@ -48,7 +48,7 @@ namespace Parser
 		auto levelObj = std::make_shared<ImageLevelObject>(*texture);
 
 		levelObj->MapPosition(mapPos);
-		mapCell.addFront(levelObj);
+		level->Map().addFront(mapPos, levelObj);
 
 		levelObj->Hoverable(getBoolKey(elem, "enableHover", true));
 
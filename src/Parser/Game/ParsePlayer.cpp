@@ -170,7 +170,7 @@ namespace Parser
 
 		player->applyDefaults();
 
-		mapCell.addBack(player);
+		level->Map().addBack(mapPos, player);
 		player->MapPosition(mapPos);
 		player->MapPosition(*level, mapPos);
 
@@ -180,6 +180,8 @@ namespace Parser
 		player->setStatus(getPlayerStatusKey(elem, "status"));
 		player->setRestStatus((uint8_t)getUIntKey(elem, "restStatus"));
 		player->setTextureIdx(getUIntKey(elem, "textureIndex"));
+		player->setWalkMode(GameUtils::getPlayerWalkMode(
+			getStringKey(elem, "walkMode"), PlayerWalkMode::Path));
 
 		player->Id(id);
 		player->Name(getStringKey(elem, "name"));
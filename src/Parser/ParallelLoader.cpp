@@ -0,0 +1,330 @@
+#include "ParallelLoader.h"
+#include <algorithm>
+#include "Cel.h"
+#include "FileUtils.h"
+#include "Game.h"
+#include "Palette.h"
+#include "ParseCelFile.h"
+#include "ParseTexture.h"
+#ifndef USE_PARALLEL_LOAD_NO_THREAD
+#include <system_error>
+#include <thread>
+#endif
+#include "Utils.h"
+#include "Utils/ParseUtils.h"
+
+namespace Parser
+{
+	using namespace rapidjson;
+
+	// the loader used by the parse functions (main thread only)
+	static thread_local ParallelLoader* currentLoader{ nullptr };
+
+	ParallelLoader::ParallelLoader(Game& game_) : game(game_), previous(currentLoader)
+	{
+		currentLoader = this;
+	}
+
+	ParallelLoader::~ParallelLoader()
+	{
+		currentLoader = previous;
+	}
+
+	bool ParallelLoader::getPalette(const Value& elem, Resource& res) const
+	{
+		if (isValidString(elem, "palette") == false)
+		{
+			return false;
+		}
+		std::string id(elem["palette"].GetString());
+		res.inputPalette = game.Resources().getPalette(id);
+		if (res.inputPalette != nullptr)
+		{
+			return true;
+		}
+		auto it = paletteIndexes.find(id);
+		if (it != paletteIndexes.end())
+		{
+			res.dependency = it->second;
+			return true;
+		}
+		return false;
+	}
+
+	void ParallelLoader::add(uint16_t type, const Value& elem)
+	{
+		if (elem.IsObject() == false ||
+			elem.HasMember("fromId") == true ||
+			getBoolKey(elem, "lazy") == true ||
+			getBoolKey(elem, "replaceVars") == true)
+		{
+			return;
+		}
+		Resource res;
+		res.elem = &elem;
+		res.type = type;
+
+		switch (type)
+		{
+		case str2int16("palette"):
+		{
+			std::string file;
+			if (isValidString(elem, "file") == true)
+			{
+				file = elem["file"].GetString();
+			}
+			else if (isValidString(elem, "trnFile") == true &&
+				getPalette(elem, res) == true)
+			{
+				file = elem["trnFile"].GetString();
+			}
+			else
+			{
+				return;
+			}
+			std::string id;
+			if (isValidString(elem, "id") == true)
+			{
+				id = elem["id"].GetString();
+			}
+			else if (getIdFromFile(file, id) == false)
+			{
+				return;
+			}
+			if (isValidId(id) == false ||
+				game.Resources().hasPalette(id) == true ||
+				paletteIndexes.find(id) != paletteIndexes.end())
+			{
+				return;
+			}
+			paletteIndexes[id] = resources.size();
+			break;
+		}
+		case str2int16("celFile"):
+		{
+			if (isValidString(elem, "file") == false)
+			{
+				return;
+			}
+			break;
+		}
+		case str2int16("celTexture"):
+		{
+			if (isValidString(elem, "file") == false ||
+				isValidString(elem, "palette") == false)
+			{
+				return;
+			}
+			break;
+		}
+		case str2int16("bitmapFont"):
+		case str2int16("texture"):
+		{
+			if ((type == str2int16("bitmapFont") &&
+				(elem.HasMember("texture") == true || isValidString(elem, "textureId") == false)) ||
+				elem.HasMember("fill") == true ||
+				isValidString(elem, "file") == false)
+			{
+				return;
+			}
+			if (elem.HasMember("palette") == true &&
+				getPalette(elem, res) == false)
+			{
+				return;
+			}
+			break;
+		}
+		default:
+			return;
+		}
+		resourceIndexes[&elem] = resources.size();
+		resources.push_back(std::move(res));
+	}
+
+	void ParallelLoader::decode(Resource& res)
+	{
+		const auto& elem = *res.elem;
+		switch (res.type)
+		{
+		case str2int16("palette"):
+		{
+			if (isValidString(elem, "file") == true)
+			{
+				res.palette = std::make_shared<Palette>(elem["file"].GetString());
+			}
+			else if (res.inputPalette != nullptr)
+			{
+				auto trnFile = FileUtils::readChar(elem["trnFile"].GetString());
+				if (trnFile.size() >= 256)
+				{
+					res.palette = std::make_shared<Palette>(*res.inputPalette, trnFile);
+				}
+			}
+			break;
+		}
+		case str2int16("celFile"):
+		case str2int16("celTexture"):
+			res.celFile = parseCelFileObj(game, elem);
+			break;
+		case str2int16("bitmapFont"):
+		case str2int16("texture"):
+			if (elem.HasMember("palette") == true && res.inputPalette == nullptr)
+			{
+				break;
+			}
+			res.image = decodeTextureImg(game, elem, res.inputPalette.get());
+			break;
+		default:
+			break;
+		}
+	}
+
+#ifndef USE_PARALLEL_LOAD_NO_THREAD
+	void ParallelLoader::runWorker()
+	{
+		while (true)
+		{
+			size_t idx;
+			{
+				std::unique_lock<std::mutex> lock(mutex);
+				if (nextResource >= resources.size())
+				{
+					return;
+				}
+				idx = nextResource++;
+				// dependencies come first, so they're already being decoded
+				auto dependency = resources[idx].dependency;
+				if (dependency != noDependency)
+				{
+					condition.wait(lock, [this, dependency] { return resources[dependency].decoded; });
+					resources[idx].inputPalette = resources[dependency].palette;
+				}
+			}
+			decode(resources[idx]);
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+				resources[idx].decoded = true;
+			}
+			condition.notify_all();
+		}
+	}
+#endif
+
+	void ParallelLoader::load(const Value& doc)
+	{
+#ifndef USE_PARALLEL_LOAD_NO_THREAD
+		for (auto it = doc.MemberBegin(); it != doc.MemberEnd(); ++it)
+		{
+			auto type = str2int16(it->name.GetString());
+			switch (type)
+			{
+			// stops at the elements that can run actions or change the mounted files
+			case str2int16("action"):
+			case str2int16("init"):
+			case str2int16("load"):
+			case str2int16("mountFile"):
+			case str2int16("replaceVars"):
+			case str2int16("saveDir"):
+				break;
+			default:
+			{
+				if (it->value.IsArray() == false)
+				{
+					add(type, it->value);
+				}
+				else
+				{
+					for (const auto& val : it->value)
+					{
+						add(type, val);
+					}
+				}
+				continue;
+			}
+			}
+			break;
+		}
+		if (resources.size() < 2)
+		{
+			return;
+		}
+
+		// the main thread decodes too
+		auto numWorkers = std::min((size_t)std::thread::hardware_concurrency(), resources.size());
+		std::vector<std::thread> workers;
+		try
+		{
+			for (size_t i = 1; i < numWorkers; i++)
+			{
+				workers.push_back(std::thread(&ParallelLoader::runWorker, this));
+			}
+		}
+		catch (const std::system_error&)
+		{
+			// fewer workers, the main thread decodes the rest
+		}
+		runWorker();
+		for (auto& worker : workers)
+		{
+			worker.join();
+		}
+#endif
+	}
+
+	ParallelLoader::Resource* ParallelLoader::find(const Value& elem)
+	{
+		if (currentLoader == nullptr)
+		{
+			return nullptr;
+		}
+		auto it = currentLoader->resourceIndexes.find(&elem);
+		if (it == currentLoader->resourceIndexes.end())
+		{
+			return nullptr;
+		}
+		auto& res = currentLoader->resources[it->second];
+		if (res.decoded == false)
+		{
+			return nullptr;
+		}
+		return &res;
+	}
+
+	bool ParallelLoader::takeImage(const Value& elem, sf::Image& image)
+	{
+		auto res = find(elem);
+		if (res == nullptr)
+		{
+			return false;
+		}
+		auto imgSize = res->image.getSize();
+		if (imgSize.x == 0 || imgSize.y == 0)
+		{
+			// decode it again, in case it failed because of a previous element
+			return false;
+		}
+		image = std::move(res->image);
+		res->image = sf::Image();
+		return true;
+	}
+
+	std::shared_ptr<CelFile> ParallelLoader::takeCelFile(const Value& elem)
+	{
+		auto res = find(elem);
+		if (res == nullptr)
+		{
+			return nullptr;
+		}
+		return std::move(res->celFile);
+	}
+
+	std::shared_ptr<Palette> ParallelLoader::takePalette(const Value& elem)
+	{
+		auto res = find(elem);
+		if (res == nullptr)
+		{
+			return nullptr;
+		}
+		return std::move(res->palette);
+	}
+}
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include "Json/JsonParser.h"
+#include <memory>
+#ifndef USE_PARALLEL_LOAD_NO_THREAD
+#include <condition_variable>
+#include <mutex>
+#endif
+#include <SFML/Graphics/Image.hpp>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class CelFile;
+class Game;
+class Palette;
+
+namespace Parser
+{
+	// Decodes the images, cel files and palettes declared in a document on
+	// worker threads before the document is parsed. The document is still
+	// parsed in order on the main thread, which takes the decoded resource
+	// of an element instead of decoding it, so the resources are added to
+	// the ResourceManager in the same order. A texture or trn palette that
+	// needs a palette declared earlier in the document waits for it to be
+	// decoded. The scan stops at the first element that can run actions or
+	// change the mounted files.
+	class ParallelLoader
+	{
+	private:
+		static const size_t noDependency = (size_t)-1;
+
+		struct Resource
+		{
+			const rapidjson::Value* elem{ nullptr };
+			uint16_t type{ 0 };
+			// the palette needed to decode it, from the game's resources
+			// or from another resource of the document
+			std::shared_ptr<Palette> inputPalette;
+			size_t dependency{ noDependency };
+			// decoded
+			std::shared_ptr<Palette> palette;
+			std::shared_ptr<CelFile> celFile;
+			sf::Image image;
+			bool decoded{ false };
+		};
+
+		Game& game;
+		std::vector<Resource> resources;
+		std::unordered_map<const rapidjson::Value*, size_t> resourceIndexes;
+		std::unordered_map<std::string, size_t> paletteIndexes;
+		ParallelLoader* previous{ nullptr };
+
+#ifndef USE_PARALLEL_LOAD_NO_THREAD
+		// guards nextResource and the decoded flags
+		std::mutex mutex;
+		std::condition_variable condition;
+		size_t nextResource{ 0 };
+
+		void runWorker();
+#endif
+
+		bool getPalette(const rapidjson::Value& elem, Resource& res) const;
+		void add(uint16_t type, const rapidjson::Value& elem);
+		void decode(Resource& res);
+
+		static Resource* find(const rapidjson::Value& elem);
+
+	public:
+		ParallelLoader(Game& game_);
+		~ParallelLoader();
+
+		ParallelLoader(const ParallelLoader&) = delete;
+		ParallelLoader& operator=(const ParallelLoader&) = delete;
+
+		// decodes the resources of doc. They're used by the parse functions
+		// while this loader exists.
+		void load(const rapidjson::Value& doc);
+
+		// these return the decoded resource of elem, if there's one.
+		static bool takeImage(const rapidjson::Value& elem, sf::Image& image);
+		static std::shared_ptr<CelFile> takeCelFile(const rapidjson::Value& elem);
+		static std::shared_ptr<Palette> takePalette(const rapidjson::Value& elem);
+	};
+}
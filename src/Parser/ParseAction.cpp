@@ -597,6 +597,10 @@ namespace Parser
 		{
 			return std::make_shared<ActGamePauseOnFocusLoss>(getBoolKey(elem, "pause", true));
 		}
+		case str2int16("game.saveProfile"):
+		{
+			return std::make_shared<ActGameSaveProfile>(getStringKey(elem, "file"));
+		}
 		case str2int16("game.setMusicVolume"):
 		{
 			return std::make_shared<ActGameSetMusicVolume>(getVariableKey(elem, "volume"));
@@ -795,6 +799,14 @@ namespace Parser
 				getStringKey(elem, "level"),
 				getItemCoordInventoryVal(elem));
 		}
+		case str2int16("level.benchmarkPathFinder"):
+		{
+			return std::make_shared<ActLevelBenchmarkPathFinder>(
+				getStringKey(elem, "level"),
+				getStringKey(elem, "file"),
+				(size_t)getUIntKey(elem, "searches", 1000),
+				(uint32_t)getUIntKey(elem, "seed", 5489));
+		}
 		case str2int16("level.clearObjects"):
 		{
 			return std::make_shared<ActLevelClearObjects>(getStringKey(elem, "level"));
@@ -1082,8 +1094,28 @@ namespace Parser
 				action->setIgnorePrevious(
 					getIgnoreResourceVal(elem["ignorePrevious"]));
 			}
+			if (elem.HasMember("opaque") == true)
+			{
+				// true (the whole screen) or a rect
+				const auto& opaqueElem = elem["opaque"];
+				if (opaqueElem.IsBool() == true)
+				{
+					if (opaqueElem.GetBool() == true)
+					{
+						action->setOpaque({});
+					}
+				}
+				else
+				{
+					action->setOpaque(getFloatRectVal(opaqueElem));
+				}
+			}
 			return action;
 		}
+		case str2int16("resource.evict"):
+		{
+			return std::make_shared<ActResourceEvict>();
+		}
 		case str2int16("resource.ignore"):
 		{
 			return std::make_shared<ActResourceIgnore>(
@@ -1103,6 +1135,11 @@ namespace Parser
 				getBoolKey(elem, "popBase"),
 				getIgnoreResourceKey(elem, "ignorePrevious"));
 		}
+		case str2int16("resource.prefetch"):
+		{
+			return std::make_shared<ActResourcePrefetch>(
+				getStringVectorKey(elem, "id"));
+		}
 		case str2int16("sound.loadPlay"):
 		{
 			return std::make_shared<ActSoundLoadPlay>(
@@ -1151,8 +1188,15 @@ namespace Parser
 		}
 		case str2int16("variable.clear"):
 		{
+			auto key = getStringKey(elem, "key");
+			if ((key.size() <= 2) ||
+				(key.front() != '%') ||
+				(key.back() != '%'))
+			{
+				return nullptr;
+			}
 			return std::make_shared<ActVariableClear>(
-				getStringKey(elem, "key"));
+				game.getVariableId(key.substr(1, key.size() - 2)));
 		}
 		case str2int16("variable.save"):
 		{
@@ -1168,7 +1212,7 @@ namespace Parser
 				return nullptr;
 			}
 			return std::make_shared<ActVariableSet>(
-				key,
+				game.getVariableId(key),
 				getVariableKey(elem, "val"));
 		}
 		case str2int16("variable.setId"):
@@ -1180,7 +1224,7 @@ namespace Parser
 			}
 			return std::make_shared<ActVariableSetId>(
 				getStringKey(elem, "id"),
-				key,
+				game.getVariableId(key),
 				getStringKey(elem, "property"));
 		}
 		case str2int16("variable.setIfNull"):
@@ -1191,7 +1235,7 @@ namespace Parser
 				return nullptr;
 			}
 			return std::make_shared<ActVariableSetIfNull>(
-				key,
+				game.getVariableId(key),
 				getVariableKey(elem, "val"));
 		}
 		default:
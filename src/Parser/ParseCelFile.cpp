@@ -1,5 +1,6 @@
 #include "ParseCelFile.h"
 #include "Cel.h"
+#include "ParallelLoader.h"
 #include "Utils.h"
 #include "Utils/ParseUtils.h"
 
@@ -83,7 +84,11 @@ namespace Parser
 		{
 			return;
 		}
-		auto celFile = parseCelFileObj(game, elem);
+		auto celFile = ParallelLoader::takeCelFile(elem);
+		if (celFile == nullptr)
+		{
+			celFile = parseCelFileObj(game, elem);
+		}
 		if (celFile == nullptr)
 		{
 			return;
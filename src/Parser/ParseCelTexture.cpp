@@ -1,6 +1,8 @@
 #include "ParseCelTexture.h"
 #include "ParseCelFile.h"
 #include "CelCache.h"
+#include "Json/JsonUtils.h"
+#include "ParallelLoader.h"
 #include "Utils/ParseUtils.h"
 
 namespace Parser
@@ -29,6 +31,32 @@ namespace Parser
 		return false;
 	}
 
+	static void parseLazyCelTexture(Game& game, const Value& elem, const std::string& id)
+	{
+		auto pal = game.Resources().getPalette(elem["palette"].GetString());
+		if (pal == nullptr)
+		{
+			return;
+		}
+		// the element is copied, since the document (and its text) is reused
+		// after parsing it
+		auto celElem = std::make_shared<Document>();
+		JsonUtils::copyToDocument(elem, *celElem);
+
+		game.Resources().addLazyCelTextureCache(id,
+			[&game, celElem, pal]() -> std::shared_ptr<CelTextureCache>
+		{
+			auto cel = parseCelFileObj(game, *celElem);
+			if (cel == nullptr)
+			{
+				return nullptr;
+			}
+			// the cache points to its cel file and palette, so it keeps them
+			return std::shared_ptr<CelTextureCache>(new CelTextureCache(*cel, *pal),
+				[cel, pal](CelTextureCache* obj) { delete obj; });
+		});
+	}
+
 	void parseCelTexture(Game& game, const Value& elem)
 	{
 		if (parseCelTextureFromId(game, elem) == true)
@@ -73,7 +101,16 @@ namespace Parser
 			{
 				return;
 			}
-			auto cel = parseCelFileObj(game, elem);
+			if (getBoolKey(elem, "lazy") == true)
+			{
+				parseLazyCelTexture(game, elem, id);
+				return;
+			}
+			auto cel = ParallelLoader::takeCelFile(elem);
+			if (cel == nullptr)
+			{
+				cel = parseCelFileObj(game, elem);
+			}
 			if (cel != nullptr)
 			{
 				celObj = cel.get();
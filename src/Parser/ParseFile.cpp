@@ -1,8 +1,11 @@
 #include "ParseFile.h"
 
 #include <cstdarg>
+#include <cstring>
 #include "FileUtils.h"
 #include "Json/JsonUtils.h"
+#include "Json/PooledDocument.h"
+#include "ParallelLoader.h"
 #include "ParseAction.h"
 #include "ParseAnimation.h"
 #include "ParseAudio.h"
@@ -52,6 +55,33 @@ namespace Parser
 	void parseDocumentElemHelper(Game& game, uint16_t nameHash16, const Value& elem,
 		ReplaceVars& replaceVars, MemoryPoolAllocator<CrtAllocator>& allocator);
 
+	// parses the text of json (in place) into its document.
+	static void parseJson(Game& game, PooledDocument& json,
+		const std::string& fileName)
+	{
+		if (json.Text().empty() == true)
+		{
+			return;
+		}
+
+		auto& doc = json.Doc();
+		if (game.getJsonCache().parse(fileName, json.Text(), doc, false) == false)
+		{
+			return;
+		}
+
+		parseDocument(game, doc);
+	}
+
+	// only the game files are cached on disk, not the saved games.
+	static bool isGameFile(const std::string& fileName)
+	{
+		auto realDir = PHYSFS_getRealDir(fileName.c_str());
+		auto writeDir = PHYSFS_getWriteDir();
+		return (realDir != nullptr &&
+			(writeDir == nullptr || std::strcmp(realDir, writeDir) != 0));
+	}
+
 	void parseFile(Game& game, const std::string& fileName)
 	{
 		if (fileName == "null")
@@ -59,7 +89,19 @@ namespace Parser
 			return;
 		}
 
-		parseJson(game, FileUtils::readText(fileName.c_str()));
+		ParseTraceScope traceScope(game.getParseTracer(), fileName);
+		PooledDocument json;
+		if (isGameFile(fileName) == true)
+		{
+			// cached game files aren't read
+			if (game.getJsonCache().parseFile(fileName, json.Text(), json.Doc()) == true)
+			{
+				parseDocument(game, json.Doc());
+			}
+			return;
+		}
+		FileUtils::readText(fileName.c_str(), json.Text());
+		parseJson(game, json, fileName);
 	}
 
 	void parseFile(Game& game, const std::vector<std::string>& params)
@@ -75,13 +117,15 @@ namespace Parser
 			return;
 		}
 
-		auto json = FileUtils::readText(fileName.c_str());
+		ParseTraceScope traceScope(game.getParseTracer(), fileName);
+		std::vector<std::string> fileParams;
 		for (size_t i = 1; i < params.size(); i++)
 		{
-			auto param = game.getVarOrPropString(params[i]);
-			Utils::replaceStringInPlace(json, "{" + std::to_string(i) + "}", param);
+			fileParams.push_back(game.getVarOrPropString(params[i]));
 		}
-		parseJson(game, json);
+		PooledDocument json;
+		game.getFileTemplates().expand(fileName, fileParams, json.Text());
+		parseJson(game, json, fileName);
 	}
 
 	void parseFile(Game& game, const Value& params)
@@ -101,46 +145,52 @@ namespace Parser
 			return;
 		}
 
-		auto json = FileUtils::readText(fileName.c_str());
+		ParseTraceScope traceScope(game.getParseTracer(), fileName);
+		std::vector<std::string> fileParams;
 		for (size_t i = 1; i < params.Size(); i++)
 		{
-			auto param = game.getVarOrPropString(getStringVal(params[i]));
-			Utils::replaceStringInPlace(json, "{" + std::to_string(i) + "}", param);
+			fileParams.push_back(game.getVarOrPropString(getStringVal(params[i])));
 		}
-		parseJson(game, json);
+		PooledDocument json;
+		game.getFileTemplates().expand(fileName, fileParams, json.Text());
+		parseJson(game, json, fileName);
 	}
 
 	void parseJson(Game& game, const std::string& str)
 	{
-		if (str.empty() == true)
-		{
-			return;
-		}
-
-		rapidjson::Document doc;  // Default template parameter uses UTF8 and MemoryPoolAllocator.
-
-		if (doc.Parse(str.c_str()).HasParseError() == true)
-		{
-			return;
-		}
-
-		parseDocument(game, doc);
+		PooledDocument json;
+		json.Text().assign(str);
+		parseJson(game, json, "");
 	}
 
 	void parseDocument(Game& game, const Document& doc, ReplaceVars replaceVars_)
 	{
 		ReplaceVars replaceVars = replaceVars_;
 		MemoryPoolAllocator<CrtAllocator> allocator;
+		ParallelLoader loader(game);
+		if (game.ParallelLoad() == true && replaceVars == ReplaceVars::None)
+		{
+			loader.load(doc);
+		}
+		auto& tracer = game.getParseTracer();
 		for (auto it = doc.MemberBegin(); it != doc.MemberEnd(); ++it)
 		{
-			parseDocumentElemHelper(game, str2int16(it->name.GetString()),
-				it->value, replaceVars, allocator);
+			auto nameHash16 = str2int16(it->name.GetString());
+			if (tracer.Enabled() == true)
+			{
+				tracer.setTypeName(nameHash16, it->name.GetString());
+			}
+			parseDocumentElemHelper(game, nameHash16, it->value, replaceVars, allocator);
 		}
 	}
 
 	void parseDocumentElemHelper(Game& game, uint16_t nameHash16, const Value& elem,
 		ReplaceVars& replaceVars, MemoryPoolAllocator<CrtAllocator>& allocator)
 	{
+		// arrays are traced as their elements (a load's array is its params)
+		ParseTraceScope traceScope(game.getParseTracer(), nameHash16,
+			elem.IsArray() == false || nameHash16 == str2int16("load"));
+
 		bool replaceVarsInElem = false;
 		if (elem.IsObject() == true)
 		{
@@ -352,6 +402,14 @@ namespace Parser
 			}
 			break;
 		}
+		case str2int16("jsonCache"): {
+			game.getJsonCache().Enabled(getBoolVal(elem, true));
+			break;
+		}
+		case str2int16("jsonCacheDir"): {
+			game.getJsonCache().Dir(getStringVal(elem));
+			break;
+		}
 		case str2int16("keepAR"): {
 			game.KeepAR(getBoolVal(elem, true));
 			break;
@@ -367,6 +425,10 @@ namespace Parser
 			}
 			break;
 		}
+		case str2int16("lazyResourcesMaxSize"): {
+			game.Resources().LazyMaxSize((size_t)getUInt64Val(elem));
+			break;
+		}
 		case str2int16("level"): {
 			if (elem.IsArray() == false) {
 				parseLevel(game, elem);
@@ -451,6 +513,14 @@ namespace Parser
 			}
 			break;
 		}
+		case str2int16("occlusion"): {
+			game.Occlusion(getBoolVal(elem, true));
+			break;
+		}
+		case str2int16("occlusionUpdate"): {
+			game.OcclusionUpdate(getBoolVal(elem));
+			break;
+		}
 		case str2int16("palette"): {
 			if (elem.IsArray() == false) {
 				parsePalette(game, elem);
@@ -462,6 +532,10 @@ namespace Parser
 			}
 			break;
 		}
+		case str2int16("parallelLoad"): {
+			game.ParallelLoad(getBoolVal(elem));
+			break;
+		}
 		case str2int16("player"): {
 			if (elem.IsArray() == false) {
 				parsePlayer(game, elem);
@@ -575,6 +649,10 @@ namespace Parser
 			}
 			break;
 		}
+		case str2int16("tickRate"): {
+			game.TickRate(getUIntVal(elem));
+			break;
+		}
 		case str2int16("title"): {
 			game.setTitle(getStringVal(elem, game.getTitle()));
 			break;
@@ -47,6 +47,7 @@ namespace Parser
 		}
 		image->Position(pos);
 		image->Visible(getBoolKey(elem, "visible", true));
+		image->Opaque(getBoolKey(elem, "opaque"));
 
 		image->setColor(getColorKey(elem, "color", sf::Color::White));
 
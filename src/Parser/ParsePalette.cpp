@@ -1,6 +1,7 @@
 #include "ParseFont.h"
 #include "FileUtils.h"
 #include "Palette.h"
+#include "ParallelLoader.h"
 #include "Utils/ParseUtils.h"
 
 namespace Parser
@@ -58,7 +59,11 @@ namespace Parser
 				return;
 			}
 
-			auto palette = std::make_shared<Palette>(file);
+			auto palette = ParallelLoader::takePalette(elem);
+			if (palette == nullptr)
+			{
+				palette = std::make_shared<Palette>(file);
+			}
 			game.Resources().addPalette(id, palette);
 		}
 		else if (isValidString(elem, "palette") == true
@@ -84,6 +89,12 @@ namespace Parser
 				return;
 			}
 
+			auto palette = ParallelLoader::takePalette(elem);
+			if (palette != nullptr)
+			{
+				game.Resources().addPalette(id, palette);
+				return;
+			}
 			auto refPalette = game.Resources().getPalette(elem["palette"].GetString());
 			if (refPalette == nullptr)
 			{
@@ -94,7 +105,7 @@ namespace Parser
 			{
 				return;
 			}
-			auto palette = std::make_shared<Palette>(*refPalette.get(), trnFile);
+			palette = std::make_shared<Palette>(*refPalette.get(), trnFile);
 			game.Resources().addPalette(id, palette);
 		}
 	}
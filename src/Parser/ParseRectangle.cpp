@@ -51,6 +51,7 @@ namespace Parser
 		}
 		rectangle->Position(pos);
 		rectangle->Visible(getBoolKey(elem, "visible", true));
+		rectangle->Opaque(getBoolKey(elem, "opaque"));
 
 		rectangle->setFillColor(getColorKey(elem, "color", sf::Color::White));
 		rectangle->setOutlineColor(getColorKey(elem, "outlineColor", sf::Color::White));
@@ -5,8 +5,7 @@ namespace Parser
 {
 	using namespace rapidjson;
 
-	std::shared_ptr<sf::SoundBuffer> parseSoundObj(Game& game,
-		const std::string& id, const std::string& file)
+	std::shared_ptr<sf::SoundBuffer> loadSoundObj(const std::string& file)
 	{
 		sf::PhysFSStream stream(file);
 		if (stream.hasError() == true)
@@ -19,7 +18,17 @@ namespace Parser
 		{
 			return nullptr;
 		}
+		return sound;
+	}
 
+	std::shared_ptr<sf::SoundBuffer> parseSoundObj(Game& game,
+		const std::string& id, const std::string& file)
+	{
+		auto sound = loadSoundObj(file);
+		if (sound == nullptr)
+		{
+			return nullptr;
+		}
 		game.Resources().addSound(id, sound);
 		return sound;
 	}
@@ -74,9 +83,16 @@ namespace Parser
 			return;
 		}
 
+		auto play = getBoolKey(elem, "play");
+		if (getBoolKey(elem, "lazy") == true && play == false)
+		{
+			game.Resources().addLazySound(id, [file]() { return loadSoundObj(file); });
+			return;
+		}
+
 		auto sndBuffer = parseSoundObj(game, id, file);
 
-		if (getBoolKey(elem, "play") == true)
+		if (play == true && sndBuffer != nullptr)
 		{
 			sf::Sound sound(*sndBuffer.get());
 
@@ -5,6 +5,7 @@
 
 namespace Parser
 {
+	std::shared_ptr<sf::SoundBuffer> loadSoundObj(const std::string& file);
 	std::shared_ptr<sf::SoundBuffer> parseSoundObj(Game& game,
 		const std::string& id, const std::string& file);
 	void parseSound(Game& game, const rapidjson::Value& elem);
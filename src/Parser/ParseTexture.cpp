@@ -2,6 +2,8 @@
 #include "ParseCelFile.h"
 #include "CelUtils.h"
 #include "ImageUtils.h"
+#include "Json/JsonUtils.h"
+#include "ParallelLoader.h"
 #include "Utils.h"
 #include "Utils/ParseUtils.h"
 
@@ -24,9 +26,31 @@ namespace Parser
 		{
 			return img;
 		}
+		if (numFramesX == nullptr &&
+			numFramesY == nullptr &&
+			ParallelLoader::takeImage(elem, img) == true)
+		{
+			return img;
+		}
 		if (elem.HasMember("palette"))
 		{
 			auto pal = game.Resources().getPalette(getStringVal(elem["palette"]));
+			if (pal == nullptr)
+			{
+				return img;
+			}
+			return decodeTextureImg(game, elem, pal.get(), numFramesX, numFramesY);
+		}
+		return decodeTextureImg(game, elem, nullptr, numFramesX, numFramesY);
+	}
+
+	sf::Image decodeTextureImg(Game& game, const rapidjson::Value& elem,
+		const Palette* pal, size_t* numFramesX, size_t* numFramesY)
+	{
+		sf::Image img;
+
+		if (elem.HasMember("palette"))
+		{
 			if (pal == nullptr)
 			{
 				return img;
@@ -110,6 +134,45 @@ namespace Parser
 		return false;
 	}
 
+	static std::shared_ptr<sf::Texture> loadTexture(const sf::Image& img, bool repeat)
+	{
+		auto imgSize = img.getSize();
+		if (imgSize.x == 0 || imgSize.y == 0)
+		{
+			return nullptr;
+		}
+		auto texture = std::make_shared<sf::Texture>();
+		if (texture->loadFromImage(img) == false)
+		{
+			return nullptr;
+		}
+		texture->setRepeated(repeat);
+		return texture;
+	}
+
+	static void parseLazyTexture(Game& game, const Value& elem, const std::string& id)
+	{
+		std::shared_ptr<Palette> pal;
+		if (elem.HasMember("palette"))
+		{
+			pal = game.Resources().getPalette(getStringVal(elem["palette"]));
+			if (pal == nullptr)
+			{
+				return;
+			}
+		}
+		// the element is copied, since the document (and its text) is reused
+		// after parsing it
+		auto texElem = std::make_shared<Document>();
+		JsonUtils::copyToDocument(elem, *texElem);
+		auto repeat = getBoolKey(elem, "repeat", true);
+
+		game.Resources().addLazyTexture(id, [&game, texElem, pal, repeat]()
+		{
+			return loadTexture(decodeTextureImg(game, *texElem, pal.get()), repeat);
+		});
+	}
+
 	void parseTexture(Game& game, const Value& elem)
 	{
 		if (parseTextureFromId(game, elem) == true)
@@ -138,20 +201,20 @@ namespace Parser
 			return;
 		}
 
-		auto img = parseTextureImg(game, elem);
-		auto imgSize = img.getSize();
-		if (imgSize.x == 0 || imgSize.y == 0)
+		if (getBoolKey(elem, "lazy") == true &&
+			elem.HasMember("fill") == false &&
+			isValidString(elem, "file") == true)
 		{
+			parseLazyTexture(game, elem, id);
 			return;
 		}
-		auto texture = std::make_shared<sf::Texture>();
-		if (texture->loadFromImage(img) == false)
+
+		auto texture = loadTexture(parseTextureImg(game, elem), getBoolKey(elem, "repeat", true));
+		if (texture == nullptr)
 		{
 			return;
 		}
 
-		texture->setRepeated(getBoolKey(elem, "repeat", true));
-
 		game.Resources().addTexture(id, texture);
 	}
 }
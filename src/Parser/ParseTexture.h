@@ -7,5 +7,11 @@ namespace Parser
 {
 	sf::Image parseTextureImg(Game& game, const rapidjson::Value& elem,
 		size_t* numFramesX = nullptr, size_t* numFramesY = nullptr);
+
+	// decodes the image of a texture from a file, or from a cel file with pal
+	// if it has a palette. Doesn't use the game's resources, so it can run
+	// on a worker thread.
+	sf::Image decodeTextureImg(Game& game, const rapidjson::Value& elem,
+		const Palette* pal, size_t* numFramesX = nullptr, size_t* numFramesY = nullptr);
 	void parseTexture(Game& game, const rapidjson::Value& elem);
 }
@@ -1,5 +1,6 @@
 #include "Parser.h"
 #include "FileUtils.h"
+#include "Json/PooledDocument.h"
 #include "ParseFile.h"
 #include "Utils.h"
 #include "Utils/ParseUtils.h"
@@ -19,9 +20,12 @@ namespace Parser
 #endif
 		}
 
-		rapidjson::Document doc;  // Default template parameter uses UTF8 and MemoryPoolAllocator.
+		ParseTraceScope traceScope(game.getParseTracer(), fileName);
+		PooledDocument json;
+		FileUtils::readText(fileName.c_str(), json.Text());
+		auto& doc = json.Doc();
 
-		if (doc.Parse(FileUtils::readText(fileName.c_str()).c_str()).HasParseError())
+		if (game.getJsonCache().parse(fileName, json.Text(), doc, false) == false)
 		{
 #if (PHYSFS_VER_MAJOR > 2 || (PHYSFS_VER_MAJOR == 2 && PHYSFS_VER_MINOR >= 1))
 			PHYSFS_unmount(filePath.c_str());
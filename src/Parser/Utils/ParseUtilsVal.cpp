@@ -5,6 +5,8 @@
 #include <cctype>
 #include "FileUtils.h"
 #include "GameUtils.h"
+#include "Predicates/PredProperty.h"
+#include "Predicates/PredVariable.h"
 #include "SFMLUtils.h"
 #include "Utils.h"
 
@@ -365,6 +367,23 @@ namespace Parser
 		{
 			return VarOrPredicate(parsePredicateObj(game, elem));
 		}
-		return VarOrPredicate(getVariableVal(elem));
+		auto var = getVariableVal(elem);
+		if (var.is<std::string>() == true)
+		{
+			// resolve variables and properties once, instead of on every execution
+			const auto& key = var.get<std::string>();
+			if ((key.size() > 2) &&
+				(key.front() == '%') &&
+				(key.back() == '%'))
+			{
+				auto id = game.getVariableId(key.substr(1, key.size() - 2));
+				return VarOrPredicate(std::make_shared<PredVariable>(id, key));
+			}
+			else if (PropertyQuery::isQuery(key) == true)
+			{
+				return VarOrPredicate(std::make_shared<PredProperty>(key));
+			}
+		}
+		return VarOrPredicate(var);
 	}
 }
@@ -20,6 +20,14 @@
 //distribution.
 
 #include "PhysFSStream.h"
+#include <atomic>
+
+static std::atomic<uint64_t> bytesRead{ 0 };
+
+uint64_t sf::PhysFSStream::getBytesRead()
+{
+	return bytesRead.load(std::memory_order_relaxed);
+}
 
 sf::PhysFSStream::PhysFSStream(const char* fileName)
 {
@@ -37,10 +45,15 @@ sf::PhysFSStream::~PhysFSStream()
 sf::Int64 sf::PhysFSStream::read(void* data, sf::Int64 size)
 {
 #if (PHYSFS_VER_MAJOR > 2 || (PHYSFS_VER_MAJOR == 2 && PHYSFS_VER_MINOR >= 1))
-	return PHYSFS_readBytes(file, data, (PHYSFS_uint64)size);
+	auto read = PHYSFS_readBytes(file, data, (PHYSFS_uint64)size);
 #else
-	return PHYSFS_read(file, data, 1, (PHYSFS_uint32)size);
+	auto read = PHYSFS_read(file, data, 1, (PHYSFS_uint32)size);
 #endif
+	if (read > 0)
+	{
+		bytesRead.fetch_add((uint64_t)read, std::memory_order_relaxed);
+	}
+	return read;
 }
 
 sf::Int64 sf::PhysFSStream::seek(sf::Int64 position)
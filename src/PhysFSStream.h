@@ -21,6 +21,7 @@
 
 #pragma once
 
+#include <cstdint>
 #include <physfs.h>
 #include <SFML/System.hpp>
 #include <string>
@@ -44,6 +45,9 @@ namespace sf
 
 		bool hasError() const { return file == NULL; }
 
+		// bytes read by all the streams so far
+		static uint64_t getBytesRead();
+
 		const char* getLastError()
 		{
 #if (PHYSFS_VER_MAJOR > 2 || (PHYSFS_VER_MAJOR == 2 && PHYSFS_VER_MINOR >= 1))
@@ -0,0 +1,26 @@
+#pragma once
+
+#include "Predicate.h"
+#include "PropertyQuery.h"
+
+// A "|id|property|" parameter parsed once into a PropertyQuery.
+// Returns the query if the property doesn't exist (same as getVarOrProp).
+class PredProperty : public Predicate
+{
+private:
+	PropertyQuery query;
+	std::string key;
+
+public:
+	PredProperty(const std::string& key_) : query(key_), key(key_) {}
+
+	virtual Variable getResult(const Game& game) const
+	{
+		Variable var;
+		if (query.getProperty(game, var) == true)
+		{
+			return var;
+		}
+		return Variable(key);
+	}
+};
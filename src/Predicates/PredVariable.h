@@ -0,0 +1,27 @@
+#pragma once
+
+#include "Game.h"
+#include "Predicate.h"
+
+// A "%name%" parameter with its variable id resolved when parsed.
+// Falls back to the key if the variable isn't set (same as getVarOrProp,
+// since a "%name%" key can't be a "|id|property|" property).
+class PredVariable : public Predicate
+{
+private:
+	uint32_t id;
+	Variable key;
+
+public:
+	PredVariable(uint32_t id_, const std::string& key_) : id(id_), key(key_) {}
+
+	virtual Variable getResult(const Game& game) const
+	{
+		Variable var;
+		if (game.getVariable(id, var) == true)
+		{
+			return var;
+		}
+		return key;
+	}
+};
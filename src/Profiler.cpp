@@ -0,0 +1,240 @@
+#include "Profiler.h"
+#include <algorithm>
+#include "FileUtils.h"
+#include "rapidjson/stringbuffer.h"
+#include "rapidjson/writer.h"
+#include "Utils.h"
+
+void Profiler::Enabled(bool enable)
+{
+	if (enabled == enable)
+	{
+		return;
+	}
+	enabled = enable;
+	if (enable == true)
+	{
+		clear();
+	}
+	else
+	{
+		// the timings are kept until enabled again
+		openScopes.clear();
+	}
+}
+
+void Profiler::clear()
+{
+	scopes.clear();
+	openScopes.clear();
+	trace.clear();
+	trace.resize(traceFrames);
+	numFrames = 0;
+
+	Scope frame;
+	frame.name = "frame";
+	frame.frameTimes.resize(statFrames);
+	scopes.push_back(std::move(frame));
+}
+
+uint32_t Profiler::getScope(uint32_t parent, const std::string& name)
+{
+	auto it = scopes[parent].children.find(name);
+	if (it != scopes[parent].children.end())
+	{
+		return it->second;
+	}
+	auto idx = (uint32_t)scopes.size();
+	Scope scope;
+	scope.name = name;
+	scope.frameTimes.resize(statFrames);
+	scopes.push_back(std::move(scope));
+	scopes[parent].children.insert(std::make_pair(name, idx));
+	return idx;
+}
+
+const Profiler::Scope* Profiler::findScope(const std::string& path) const
+{
+	if (scopes.empty() == true)
+	{
+		return nullptr;
+	}
+	if (path == scopes.front().name)
+	{
+		return &scopes.front();
+	}
+	uint32_t idx = 0;
+	size_t start = 0;
+	while (start <= path.size())
+	{
+		auto end = path.find('/', start);
+		if (end == std::string::npos)
+		{
+			end = path.size();
+		}
+		auto it = scopes[idx].children.find(path.substr(start, end - start));
+		if (it == scopes[idx].children.end())
+		{
+			return nullptr;
+		}
+		idx = it->second;
+		start = end + 1;
+	}
+	return &scopes[idx];
+}
+
+void Profiler::beginFrame()
+{
+	if (enabled == false)
+	{
+		return;
+	}
+	openScopes.clear();
+	trace[numFrames % traceFrames].clear();
+	openScopes.push_back({ 0, clock.getElapsedTime().asMicroseconds() });
+}
+
+void Profiler::endFrame()
+{
+	if (enabled == false ||
+		openScopes.empty() == true)
+	{
+		return;
+	}
+	while (openScopes.empty() == false)
+	{
+		end();
+	}
+	auto frameIdx = numFrames % statFrames;
+	for (auto& scope : scopes)
+	{
+		scope.frameTimes[frameIdx] = scope.frameTime;
+		scope.frameTime = 0;
+	}
+	numFrames++;
+}
+
+void Profiler::begin(const std::string& name)
+{
+	if (openScopes.empty() == true)
+	{
+		// not in a frame (enabled while updating)
+		return;
+	}
+	auto scope = getScope(openScopes.back().scope, name);
+	openScopes.push_back({ scope, clock.getElapsedTime().asMicroseconds() });
+}
+
+void Profiler::end()
+{
+	if (openScopes.empty() == true)
+	{
+		return;
+	}
+	auto openScope = openScopes.back();
+	openScopes.pop_back();
+	auto duration = clock.getElapsedTime().asMicroseconds() - openScope.start;
+	scopes[openScope.scope].frameTime += duration;
+	trace[numFrames % traceFrames].push_back({ openScope.scope, openScope.start, duration });
+}
+
+bool Profiler::getStats(const std::string& path, double& mean, double& p95, double& max) const
+{
+	auto numStats = std::min(numFrames, statFrames);
+	auto scope = findScope(path);
+	if (scope == nullptr || numStats == 0)
+	{
+		return false;
+	}
+	std::vector<sf::Int64> times(scope->frameTimes.begin(), scope->frameTimes.begin() + numStats);
+	sf::Int64 sum = 0;
+	for (auto time : times)
+	{
+		sum += time;
+	}
+	mean = (double)sum / (double)numStats / 1000.0;
+	max = (double)(*std::max_element(times.begin(), times.end())) / 1000.0;
+	auto p95It = times.begin() + ((numStats * 95 + 99) / 100 - 1);
+	std::nth_element(times.begin(), p95It, times.end());
+	p95 = (double)(*p95It) / 1000.0;
+	return true;
+}
+
+bool Profiler::getProperty(const std::string& prop, Variable& var) const
+{
+	switch (str2int16(prop.c_str()))
+	{
+	case str2int16("enabled"):
+		var = Variable(enabled);
+		return true;
+	case str2int16("frames"):
+		var = Variable((int64_t)std::min(numFrames, statFrames));
+		return true;
+	default:
+		break;
+	}
+	auto pos = prop.rfind('.');
+	if (pos == std::string::npos)
+	{
+		return false;
+	}
+	double mean, p95, max;
+	if (getStats(prop.substr(0, pos), mean, p95, max) == false)
+	{
+		return false;
+	}
+	switch (str2int16(prop.c_str() + pos + 1))
+	{
+	case str2int16("mean"):
+		var = Variable(mean);
+		return true;
+	case str2int16("p95"):
+		var = Variable(p95);
+		return true;
+	case str2int16("max"):
+		var = Variable(max);
+		return true;
+	default:
+		return false;
+	}
+}
+
+bool Profiler::saveTrace(const std::string& filePath) const
+{
+	if (trace.empty() == true)
+	{
+		return false;
+	}
+	rapidjson::StringBuffer buffer;
+	rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+	writer.StartObject();
+	writer.Key("traceEvents");
+	writer.StartArray();
+	// oldest frame first, the current one (if updating) last
+	for (size_t i = 1; i <= traceFrames; i++)
+	{
+		for (const auto& evt : trace[(numFrames + i) % traceFrames])
+		{
+			writer.StartObject();
+			writer.Key("name");
+			writer.String(scopes[evt.scope].name.c_str());
+			writer.Key("ph");
+			writer.String("X");
+			writer.Key("ts");
+			writer.Int64(evt.start);
+			writer.Key("dur");
+			writer.Int64(evt.duration);
+			writer.Key("pid");
+			writer.Int(1);
+			writer.Key("tid");
+			writer.Int(1);
+			writer.EndObject();
+		}
+	}
+	writer.EndArray();
+	writer.Key("displayTimeUnit");
+	writer.String("ms");
+	writer.EndObject();
+
+	return FileUtils::saveText(filePath.c_str(), buffer.GetString(), buffer.GetSize());
+}
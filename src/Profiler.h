@@ -0,0 +1,111 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <SFML/System/Clock.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <string>
+#include <unordered_map>
+#include "Variable.h"
+#include <vector>
+
+// Times nested scopes of the game loop (events, bundles, drawables, ...).
+// Scopes with the same name under the same parent are added up per frame
+// and each scope keeps its time for the last frames, to get the mean, 95th
+// percentile and max. The scopes of the last frames can be saved as a
+// Chrome trace (chrome://tracing).
+class Profiler
+{
+public:
+	// frames used for the stats
+	static const size_t statFrames = 120;
+	// frames saved in the trace
+	static const size_t traceFrames = 30;
+
+private:
+	struct Scope
+	{
+		std::string name;
+		std::unordered_map<std::string, uint32_t> children;
+		sf::Int64 frameTime{ 0 };
+		std::vector<sf::Int64> frameTimes;
+	};
+
+	struct OpenScope
+	{
+		uint32_t scope;
+		sf::Int64 start;
+	};
+
+	struct TraceEvent
+	{
+		uint32_t scope;
+		sf::Int64 start;
+		sf::Int64 duration;
+	};
+
+	sf::Clock clock;
+	// the first scope is the frame, the others are under it
+	std::vector<Scope> scopes;
+	std::vector<OpenScope> openScopes;
+	std::vector<std::vector<TraceEvent>> trace;
+	size_t numFrames{ 0 };
+	bool enabled{ false };
+
+	uint32_t getScope(uint32_t parent, const std::string& name);
+	const Scope* findScope(const std::string& path) const;
+
+public:
+	bool Enabled() const { return enabled; }
+	// enabling clears the last timings.
+	void Enabled(bool enable);
+
+	// removes all the timings.
+	void clear();
+
+	void beginFrame();
+	void endFrame();
+
+	void begin(const std::string& name);
+	void end();
+
+	// stats of a scope in milliseconds ("frame" or a path like "draw/bundle/id").
+	bool getStats(const std::string& path, double& mean, double& p95, double& max) const;
+
+	bool getProperty(const std::string& prop, Variable& var) const;
+
+	bool saveTrace(const std::string& filePath) const;
+};
+
+// Times the enclosing block if the profiler is enabled.
+class ProfilerScope : public sf::NonCopyable
+{
+private:
+	Profiler& profiler;
+	bool active;
+
+public:
+	ProfilerScope(Profiler& profiler_, const char* name)
+		: profiler(profiler_), active(profiler_.Enabled())
+	{
+		if (active == true)
+		{
+			profiler.begin(name);
+		}
+	}
+	ProfilerScope(Profiler& profiler_, const std::string& name)
+		: profiler(profiler_), active(profiler_.Enabled())
+	{
+		if (active == true)
+		{
+			profiler.begin(name);
+		}
+	}
+	~ProfilerScope()
+	{
+		if (active == true)
+		{
+			profiler.end();
+		}
+	}
+};
@@ -0,0 +1,45 @@
+#include "PropertyPath.h"
+#include <cstdlib>
+#include "Utils.h"
+
+PropertyPath::PropertyPath(const std::string& path)
+{
+	if (path.empty() == true)
+	{
+		return;
+	}
+	size_t start = 0;
+	while (true)
+	{
+		auto end = path.find('.', start);
+		if (end == std::string::npos)
+		{
+			end = path.size();
+		}
+		Segment segment;
+		segment.name = path.substr(start, end - start);
+		segment.hash = str2int16(segment.name.c_str());
+		segment.path = path.substr(start);
+		if (segment.name.empty() == false &&
+			segment.name.find_first_not_of("0123456789") == std::string::npos)
+		{
+			segment.number = std::strtoul(segment.name.c_str(), NULL, 10);
+		}
+		segments.push_back(std::move(segment));
+		if (end >= path.size())
+		{
+			break;
+		}
+		start = end + 1;
+	}
+}
+
+const std::string& PropertyPath::getString(size_t idx) const
+{
+	static const std::string emptyPath;
+	if (idx < segments.size())
+	{
+		return segments[idx].path;
+	}
+	return emptyPath;
+}
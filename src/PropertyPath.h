@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// A property path like "currentPlayer.item.body.0.name" split once in
+// segments. Each segment keeps its hash, its value if it's a number and
+// the path that follows it (including itself), so a query can walk
+// the objects in the path without splitting or allocating strings.
+class PropertyPath
+{
+public:
+	static const size_t NotANumber = (size_t)-1;
+
+	struct Segment
+	{
+		std::string name;
+		uint16_t hash{ 0 };
+		size_t number{ NotANumber };
+		// this segment and the ones after it ("item.body.0.name")
+		std::string path;
+	};
+
+private:
+	std::vector<Segment> segments;
+
+public:
+	PropertyPath() {}
+	PropertyPath(const std::string& path);
+
+	bool empty() const { return segments.empty(); }
+	size_t size() const { return segments.size(); }
+
+	const Segment& operator[](size_t idx) const { return segments[idx]; }
+
+	// the path from a segment or an empty string if idx is out of range.
+	const std::string& getString(size_t idx) const;
+};
@@ -0,0 +1,54 @@
+#include "PropertyQuery.h"
+#include "Game.h"
+
+PropertyQuery::PropertyQuery(const std::string& query)
+{
+	if (isQuery(query) == false)
+	{
+		return;
+	}
+	auto pos = query.find('|', 1);
+	id = query.substr(1, pos - 1);
+	if (pos < query.size() - 1)
+	{
+		path = PropertyPath(query.substr(pos + 1, query.size() - pos - 2));
+	}
+	isGame = (id == "game");
+	valid = true;
+}
+
+bool PropertyQuery::isQuery(const std::string& str)
+{
+	return ((str.size() > 3) &&
+		(str.front() == '|') &&
+		(str.back() == '|'));
+}
+
+bool PropertyQuery::getProperty(const Game& game, Variable& var) const
+{
+	if (valid == false)
+	{
+		return false;
+	}
+	if (isGame == true)
+	{
+		return game.queryProperty(path, 0, var);
+	}
+	const Queryable* queryable = game.Resources().getDrawable(id);
+	if (queryable == nullptr)
+	{
+		if (id == "focus")
+		{
+			queryable = game.Resources().getFocused();
+		}
+		else if (id == "currentLevel")
+		{
+			queryable = game.Resources().getCurrentLevel();
+		}
+	}
+	if (queryable != nullptr)
+	{
+		return queryable->queryProperty(path, 0, var);
+	}
+	return false;
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+#include "PropertyPath.h"
+#include <string>
+#include "Variable.h"
+
+class Game;
+
+// A "|id|property.path|" query parsed once. Evaluating it looks up the
+// object (game, drawable, focus or currentLevel) and follows the
+// precompiled path with Queryable::queryProperty.
+class PropertyQuery
+{
+private:
+	std::string id;
+	PropertyPath path;
+	bool isGame{ false };
+	bool valid{ false };
+
+public:
+	PropertyQuery() {}
+	PropertyQuery(const std::string& query);
+
+	// returns true if str is in the "|id|property|" form.
+	static bool isQuery(const std::string& str);
+
+	bool isValid() const { return valid; }
+
+	bool getProperty(const Game& game, Variable& var) const;
+};
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "PropertyPath.h"
 #include <string>
 #include "Variable.h"
 
@@ -8,4 +9,12 @@ class Queryable
 public:
 	virtual bool getProperty(const std::string& prop, Variable& var) const = 0;
 	virtual const Queryable* getQueryable(const std::string& prop) const = 0;
+
+	// gets a property from a precompiled path, starting at segment idx.
+	// objects that contain other queryables override this to follow
+	// the path without splitting it again.
+	virtual bool queryProperty(const PropertyPath& path, size_t idx, Variable& var) const
+	{
+		return getProperty(path.getString(idx), var);
+	}
 };
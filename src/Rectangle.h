@@ -8,6 +8,7 @@ class Rectangle : public sf::RectangleShape, public UIObject
 private:
 	Anchor anchor{ Anchor::Top | Anchor::Left };
 	bool visible{ true };
+	bool opaque{ false };
 
 public:
 	Rectangle(const sf::Vector2f& size = sf::Vector2f(0, 0)) : sf::RectangleShape(size) {}
@@ -27,6 +28,17 @@ public:
 	virtual bool Visible() const { return visible; }
 	virtual void Visible(bool visible_) { visible = visible_; }
 
+	void Opaque(bool opaque_) { opaque = opaque_; }
+	virtual bool getOpaqueRect(sf::FloatRect& rect) const
+	{
+		if (opaque == true && visible == true)
+		{
+			rect = this->getGlobalBounds();
+			return true;
+		}
+		return false;
+	}
+
 	virtual void draw(sf::RenderTarget& target, sf::RenderStates states) const
 	{
 		if (visible == true)
@@ -1,20 +1,85 @@
 #include "ResourceManager.h"
+#include <algorithm>
 #include "Button.h"
 #include <cctype>
 #include "ReverseIterable.h"
 
+void ResourceManager::indexDrawable(const std::string& key, size_t bundle, size_t slot)
+{
+	auto& locations = drawableIndex[key];
+	auto it = locations.begin();
+	while (it != locations.end() &&
+		(it->bundle < bundle || (it->bundle == bundle && it->slot > slot)))
+	{
+		++it;
+	}
+	locations.insert(it, { bundle, slot });
+}
+
+void ResourceManager::removeBundleFromIndex(size_t bundle)
+{
+	if (bundle >= resources.size())
+	{
+		return;
+	}
+	for (const auto& elem : resources[bundle].drawables)
+	{
+		auto it = drawableIndex.find(elem.first);
+		if (it == drawableIndex.end())
+		{
+			continue;
+		}
+		auto& locations = it->second;
+		while (locations.empty() == false &&
+			locations.back().bundle == bundle)
+		{
+			locations.pop_back();
+		}
+		if (locations.empty() == true)
+		{
+			drawableIndex.erase(it);
+		}
+	}
+}
+
+void ResourceManager::rebuildIndex()
+{
+	drawableIndex.clear();
+	for (size_t i = 0; i < resources.size(); i++)
+	{
+		const auto& drawables = resources[i].drawables;
+		for (size_t j = drawables.size(); j > 0; j--)
+		{
+			drawableIndex[drawables[j - 1].first].push_back({ i, j - 1 });
+		}
+	}
+}
+
+const std::pair<std::string, std::shared_ptr<UIObject>>* ResourceManager::findDrawable(
+	const std::string& key) const
+{
+	auto it = drawableIndex.find(key);
+	if (it != drawableIndex.end() &&
+		it->second.empty() == false)
+	{
+		const auto& location = it->second.back();
+		return &resources[location.bundle].drawables[location.slot];
+	}
+	return nullptr;
+}
+
 void ResourceManager::addResource(const std::string& id)
 {
 	resources.push_back(ResourceBundle(id));
-	clearCache();
 }
 
 void ResourceManager::popResource()
 {
 	if (resources.size() > 0)
 	{
+		// the top bundle's drawables are the last ones of their ids
+		removeBundleFromIndex(resources.size() - 1);
 		resources.pop_back();
-		clearCache();
 		clearCurrentLevel();
 	}
 }
@@ -36,7 +101,7 @@ void ResourceManager::popResource(const std::string& id)
 				currentLevelResourceIdx--;
 			}
 			resources.erase(--it.base());
-			clearCache();
+			rebuildIndex();
 			return;
 		}
 	}
@@ -49,7 +114,7 @@ void ResourceManager::popAllResources(const std::string& id)
 		if (it->id == id && it.base() != resources.begin())
 		{
 			resources.erase(--it.base(), resources.end());
-			clearCache();
+			rebuildIndex();
 			clearCurrentLevel();
 			return;
 		}
@@ -69,7 +134,7 @@ void ResourceManager::popAllResources(bool popBaseResources)
 	{
 		clearCurrentLevel();
 	}
-	clearCache();
+	rebuildIndex();
 }
 
 void ResourceManager::ignoreResources(const std::string& id, IgnoreResource ignore)
@@ -92,6 +157,15 @@ void ResourceManager::ignoreTopResource(IgnoreResource ignore)
 	}
 }
 
+void ResourceManager::setTopResourceOpaque(const sf::FloatRect& rect)
+{
+	if (resources.size() > 0)
+	{
+		resources.back().opaque = true;
+		resources.back().opaqueRect = rect;
+	}
+}
+
 bool ResourceManager::resourceExists(const std::string& id) const
 {
 	for (auto& res : resources)
@@ -220,10 +294,142 @@ void ResourceManager::addCelTextureCacheVec(ResourceBundle& res,
 	}
 }
 
+void ResourceManager::addLazyTexture(const std::string& key,
+	const std::function<std::shared_ptr<sf::Texture>()>& load)
+{
+	auto& res = resources.back();
+	if (res.textures.find(key) == res.textures.cend() &&
+		res.lazyTextures.find(key) == res.lazyTextures.cend())
+	{
+		res.lazyTextures[key].load = load;
+	}
+}
+
+void ResourceManager::addLazySound(const std::string& key,
+	const std::function<std::shared_ptr<sf::SoundBuffer>()>& load)
+{
+	auto& res = resources.back();
+	if (res.sounds.find(key) == res.sounds.cend() &&
+		res.lazySounds.find(key) == res.lazySounds.cend())
+	{
+		res.lazySounds[key].load = load;
+	}
+}
+
+void ResourceManager::addLazyCelTextureCache(const std::string& key,
+	const std::function<std::shared_ptr<CelTextureCache>()>& load)
+{
+	if (hasCelTextureCache(key) == false)
+	{
+		resources.back().lazyCelCaches[key].load = load;
+	}
+}
+
+static size_t getMemorySize(const sf::Texture& obj)
+{
+	auto size = obj.getSize();
+	return (size_t)size.x * (size_t)size.y * 4;
+}
+
+static size_t getMemorySize(const sf::SoundBuffer& obj)
+{
+	return (size_t)obj.getSampleCount() * sizeof(sf::Int16);
+}
+
+static size_t getMemorySize(const CelTextureCache& obj)
+{
+	return obj.getCelFile().DataSize();
+}
+
+template <class T>
+std::shared_ptr<T> ResourceManager::getLazyResource(LazyResource<T>& res) const
+{
+	res.lastUse = ++lazyUseCount;
+	if (res.obj == nullptr)
+	{
+		res.obj = res.load();
+		if (res.obj == nullptr)
+		{
+			return nullptr;
+		}
+		res.size = getMemorySize(*res.obj);
+		if (lazyMaxSize > 0)
+		{
+			evictLazyResources(lazyMaxSize, res.obj.get());
+		}
+	}
+	return res.obj;
+}
+
+struct LazyCandidate
+{
+	uint64_t lastUse;
+	size_t size;
+	std::function<void()> unload;
+};
+
+// canEvict is only true for the resources that every user holds by
+// shared_ptr, otherwise use_count can't tell if they're still used.
+template <class T>
+static void addLazyCandidates(std::unordered_map<std::string, LazyResource<T>>& lazyResources,
+	bool canEvict, const void* keep, size_t& loadedSize, std::vector<LazyCandidate>& candidates)
+{
+	for (auto& elem : lazyResources)
+	{
+		auto& res = elem.second;
+		if (res.obj == nullptr)
+		{
+			continue;
+		}
+		loadedSize += res.size;
+		// only the ones that nothing else uses
+		if (canEvict == true && res.obj.get() != keep && res.obj.use_count() == 1)
+		{
+			candidates.push_back({ res.lastUse, res.size, [&res]() { res.obj.reset(); } });
+		}
+	}
+}
+
+size_t ResourceManager::evictLazyResources(size_t maxSize, const void* keep) const
+{
+	size_t loadedSize = 0;
+	std::vector<LazyCandidate> candidates;
+	for (const auto& res : resources)
+	{
+		// sprites keep a reference to their texture and sounds a pointer
+		// to their buffer, so those are never unloaded
+		addLazyCandidates(res.lazyTextures, false, keep, loadedSize, candidates);
+		addLazyCandidates(res.lazySounds, false, keep, loadedSize, candidates);
+		addLazyCandidates(res.lazyCelCaches, true, keep, loadedSize, candidates);
+	}
+	std::sort(candidates.begin(), candidates.end(),
+		[](const LazyCandidate& a, const LazyCandidate& b) { return a.lastUse < b.lastUse; });
+
+	size_t freedSize = 0;
+	for (const auto& candidate : candidates)
+	{
+		if (maxSize > 0 && loadedSize - freedSize <= maxSize)
+		{
+			break;
+		}
+		candidate.unload();
+		freedSize += candidate.size;
+	}
+	return freedSize;
+}
+
+void ResourceManager::prefetch(const std::string& key)
+{
+	getTexture(key);
+	getSound(key);
+	getCelTextureCache(key);
+}
+
 void ResourceManager::addDrawable(const std::string& key, const std::shared_ptr<UIObject>& obj)
 {
-	resources.back().drawables.push_back(std::make_pair(key, obj));
-	clearCache();
+	auto& drawables = resources.back().drawables;
+	drawables.push_back(std::make_pair(key, obj));
+	indexDrawable(key, resources.size() - 1, drawables.size() - 1);
 }
 
 void ResourceManager::addPlayingSound(const sf::Sound& obj, bool unique)
@@ -323,6 +529,11 @@ std::shared_ptr<sf::Texture> ResourceManager::getTexture(const std::string& key)
 		{
 			return elem->second;
 		}
+		auto lazyElem = res.lazyTextures.find(key);
+		if (lazyElem != res.lazyTextures.end())
+		{
+			return getLazyResource(lazyElem->second);
+		}
 	}
 	return nullptr;
 }
@@ -351,6 +562,11 @@ std::shared_ptr<sf::SoundBuffer> ResourceManager::getSound(const std::string& ke
 		{
 			return elem->second;
 		}
+		auto lazyElem = res.lazySounds.find(key);
+		if (lazyElem != res.lazySounds.end())
+		{
+			return getLazyResource(lazyElem->second);
+		}
 	}
 	return nullptr;
 }
@@ -393,6 +609,11 @@ std::shared_ptr<CelTextureCache> ResourceManager::getCelTextureCache(const std::
 		{
 			return elem->second;
 		}
+		auto lazyElem = res.lazyCelCaches.find(key);
+		if (lazyElem != res.lazyCelCaches.end())
+		{
+			return getLazyResource(lazyElem->second);
+		}
 	}
 	return nullptr;
 }
@@ -439,7 +660,8 @@ bool ResourceManager::hasCelTextureCache(const std::string& key) const
 {
 	for (const auto& resource : resources)
 	{
-		if (resource.celCaches.find(key) != resource.celCaches.cend())
+		if (resource.celCaches.find(key) != resource.celCaches.cend() ||
+			resource.lazyCelCaches.find(key) != resource.lazyCelCaches.cend())
 		{
 			return true;
 		}
@@ -461,41 +683,41 @@ bool ResourceManager::hasCelTextureCacheVec(const std::string& key) const
 
 UIObject* ResourceManager::getDrawable(const std::string& key) const
 {
-	if (drawableCache.first == key)
-	{
-		return drawableCache.second;
-	}
-	for (const auto& res : reverse(resources))
+	auto elem = findDrawable(key);
+	if (elem != nullptr)
 	{
-		for (const auto& elem : res.drawables)
-		{
-			if (elem.first == key)
-			{
-				drawableCache.first = key;
-				drawableCache.second = elem.second.get();
-				return drawableCache.second;
-			}
-		}
+		return elem->second.get();
 	}
 	return nullptr;
 }
 
 void ResourceManager::deleteDrawable(const std::string& id)
 {
-	for (auto& res : reverse(resources))
+	auto it = drawableIndex.find(id);
+	if (it == drawableIndex.end() ||
+		it->second.empty() == true)
 	{
-		auto& drawables = res.drawables;
+		return;
+	}
+	auto location = it->second.back();
+	it->second.pop_back();
+	if (it->second.empty() == true)
+	{
+		drawableIndex.erase(it);
+	}
+	auto& drawables = resources[location.bundle].drawables;
+	drawables.erase(drawables.begin() + location.slot);
 
-		for (auto it = drawables.begin(); it != drawables.end(); ++it)
+	// the drawables after it in the bundle moved down one slot
+	for (size_t i = location.slot; i < drawables.size(); i++)
+	{
+		for (auto& location2 : drawableIndex[drawables[i].first])
 		{
-			if (it->first == id)
+			if (location2.bundle == location.bundle &&
+				location2.slot == i + 1)
 			{
-				if (drawableCache.first == id)
-				{
-					clearCache();
-				}
-				drawables.erase(it);
-				return;
+				location2.slot = i;
+				break;
 			}
 		}
 	}
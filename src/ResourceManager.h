@@ -5,6 +5,7 @@
 #include "BitmapFont.h"
 #include "CelCache.h"
 #include "Font2.h"
+#include <functional>
 #include "Game/Level.h"
 #include "IgnoreResource.h"
 #include <list>
@@ -20,6 +21,20 @@
 
 class Button;
 
+// A resource that is only loaded when it's first used. Cel texture caches
+// can be unloaded again while nothing else holds them and are then reloaded
+// on their next use. Textures and sounds stay loaded, since sprites and
+// playing sounds only keep a reference to them.
+template <class T>
+struct LazyResource
+{
+	std::function<std::shared_ptr<T>()> load;
+	std::shared_ptr<T> obj;
+	// memory used while loaded (estimated)
+	size_t size{ 0 };
+	uint64_t lastUse{ 0 };
+};
+
 struct ResourceBundle
 {
 	struct CompareKeyEvent
@@ -52,6 +67,9 @@ struct ResourceBundle
 	}
 
 	IgnoreResource ignore{ IgnoreResource::None };
+	// the bundle hides everything under opaqueRect (an empty rect is the whole screen)
+	bool opaque{ false };
+	sf::FloatRect opaqueRect;
 	std::string id;
 	std::unordered_map<std::string, std::shared_ptr<Action>> actions;
 	std::unordered_map<sf::Event::KeyEvent, std::shared_ptr<Action>, CompareKeyEvent, CompareKeyEvent> keyboardActions;
@@ -64,6 +82,10 @@ struct ResourceBundle
 	std::unordered_map<std::string, std::shared_ptr<CelFile>> celFiles;
 	std::unordered_map<std::string, std::shared_ptr<CelTextureCache>> celCaches;
 	std::unordered_map<std::string, std::shared_ptr<CelTextureCacheVector>> celCachesVec;
+	// loaded by the const getters
+	mutable std::unordered_map<std::string, LazyResource<sf::Texture>> lazyTextures;
+	mutable std::unordered_map<std::string, LazyResource<sf::SoundBuffer>> lazySounds;
+	mutable std::unordered_map<std::string, LazyResource<CelTextureCache>> lazyCelCaches;
 
 	std::vector<std::pair<std::string, std::shared_ptr<UIObject>>> drawables;
 	std::vector<std::shared_ptr<Button>> focusButtons;
@@ -73,18 +95,35 @@ struct ResourceBundle
 class ResourceManager
 {
 private:
+	struct DrawableLocation
+	{
+		size_t bundle;
+		size_t slot;
+	};
+
 	std::vector<ResourceBundle> resources;
 	std::vector<std::shared_ptr<UIObject>> cursors;
 	std::list<sf::Sound> playingSounds;
-	mutable std::pair<std::string, UIObject*> drawableCache{ "", nullptr };
+	// all the bundles and slots of each drawable id. They're sorted by bundle
+	// and then by slot (descending), so the visible one (the first one in the
+	// top most bundle) is the last one.
+	std::unordered_map<std::string, std::vector<DrawableLocation>> drawableIndex;
 	Level* currentLevel{ nullptr };
 	size_t currentLevelResourceIdx{ 0 };
+	// the unused lazy cel texture caches are unloaded (least recently used
+	// first) when the loaded lazy resources use more than this (0 is no limit)
+	size_t lazyMaxSize{ 0 };
+	mutable uint64_t lazyUseCount{ 0 };
 
-	void clearCache()
-	{
-		drawableCache.first.clear();
-		drawableCache.second = nullptr;
-	}
+	void indexDrawable(const std::string& key, size_t bundle, size_t slot);
+	void removeBundleFromIndex(size_t bundle);
+	void rebuildIndex();
+
+	const std::pair<std::string, std::shared_ptr<UIObject>>* findDrawable(const std::string& key) const;
+
+	template <class T>
+	std::shared_ptr<T> getLazyResource(LazyResource<T>& res) const;
+	size_t evictLazyResources(size_t maxSize, const void* keep) const;
 
 	void clearCurrentLevel()
 	{
@@ -147,6 +186,7 @@ public:
 	void popAllResources(bool popBaseResources);
 	void ignoreResources(const std::string& id, IgnoreResource ignore);
 	void ignoreTopResource(IgnoreResource ignore);
+	void setTopResourceOpaque(const sf::FloatRect& rect);
 	bool resourceExists(const std::string& id) const;
 
 	UIObject* getCursor() const;
@@ -204,6 +244,24 @@ public:
 		addCelTextureCacheVec(resources.back(), key, obj);
 	}
 
+	// lazy resources, loaded by load when first used
+	void addLazyTexture(const std::string& key,
+		const std::function<std::shared_ptr<sf::Texture>()>& load);
+	void addLazySound(const std::string& key,
+		const std::function<std::shared_ptr<sf::SoundBuffer>()>& load);
+	void addLazyCelTextureCache(const std::string& key,
+		const std::function<std::shared_ptr<CelTextureCache>()>& load);
+
+	size_t LazyMaxSize() const { return lazyMaxSize; }
+	void LazyMaxSize(size_t maxSize) { lazyMaxSize = maxSize; }
+
+	// loads the lazy resources with this id before they're used.
+	void prefetch(const std::string& key);
+
+	// unloads the loaded lazy cel texture caches that nothing else uses.
+	// returns the memory freed (estimated).
+	size_t evictLazyResources() const { return evictLazyResources(0, nullptr); }
+
 	void addDrawable(const std::string& key, const std::shared_ptr<UIObject>& obj);
 
 	void addPlayingSound(const sf::Sound& obj, bool unique = false);
@@ -233,15 +291,10 @@ public:
 	template <class T>
 	T* getResource(const std::string& key) const
 	{
-		for (auto it = resources.rbegin(); it != resources.rend(); ++it)
+		auto elem = findDrawable(key);
+		if (elem != nullptr)
 		{
-			for (const auto& elem : it->drawables)
-			{
-				if (elem.first == key)
-				{
-					return dynamic_cast<T*>(elem.second.get());
-				}
-			}
+			return dynamic_cast<T*>(elem->second.get());
 		}
 		return nullptr;
 	}
@@ -249,15 +302,10 @@ public:
 	template <class T>
 	std::shared_ptr<T> getResourceSharedPtr(const std::string& key) const
 	{
-		for (auto it = resources.rbegin(); it != resources.rend(); ++it)
+		auto elem = findDrawable(key);
+		if (elem != nullptr)
 		{
-			for (const auto& elem : it->drawables)
-			{
-				if (elem.first == key)
-				{
-					return std::dynamic_pointer_cast<T>(elem.second);
-				}
-			}
+			return std::dynamic_pointer_cast<T>(elem->second);
 		}
 		return nullptr;
 	}
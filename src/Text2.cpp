@@ -27,13 +27,12 @@ void Text2::setAction(uint16_t nameHash16, const std::shared_ptr<Action>& action
 
 void Text2::setBinding(const std::string& binding)
 {
-	bindings.clear();
-	bindings.push_back(binding);
+	bindings.set({ binding });
 }
 
 void Text2::setBinding(const std::vector<std::string>& bindings_)
 {
-	bindings = bindings_;
+	bindings.set(bindings_);
 }
 
 void Text2::update(Game& game)
@@ -42,9 +41,10 @@ void Text2::update(Game& game)
 	{
 		return;
 	}
-	if (bindings.size() > 0)
+	if (bindings.empty() == false &&
+		bindings.update(game) == true)
 	{
-		triggerOnChange = text->setText(TextUtils::getFormatString(game, format, bindings));
+		triggerOnChange = text->setText(TextUtils::formatString(format, bindings.Values()));
 	}
 	if (triggerOnChange == true)
 	{
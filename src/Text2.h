@@ -2,6 +2,7 @@
 
 #include "DrawableText.h"
 #include <memory>
+#include "TextBindings.h"
 #include "UIObject.h"
 #include "UIText.h"
 
@@ -10,7 +11,7 @@ class Text2 : public UIObject, public UIText
 private:
 	std::unique_ptr<DrawableText> text;
 	std::string format;
-	std::vector<std::string> bindings;
+	TextBindings bindings;
 	std::shared_ptr<Action> changeAction;
 	bool triggerOnChange{ false };
 
@@ -20,8 +21,17 @@ public:
 	DrawableText* getDrawableText() { return text.get(); }
 
 	virtual std::string getText() const { return text->getText(); }
-	void setText(std::unique_ptr<DrawableText> text_) { text = std::move(text_); }
-	virtual void setText(const std::string& text_) { triggerOnChange = text->setText(text_); }
+	void setText(std::unique_ptr<DrawableText> text_)
+	{
+		text = std::move(text_);
+		bindings.invalidate();
+	}
+	virtual void setText(const std::string& text_)
+	{
+		triggerOnChange = text->setText(text_);
+		// the bound text is set again on the next update
+		bindings.invalidate();
+	}
 
 	sf::FloatRect getLocalBounds() const { return text->getLocalBounds(); }
 	sf::FloatRect getGlobalBounds() const { return text->getGlobalBounds(); }
@@ -29,7 +39,11 @@ public:
 	void setBinding(const std::string& binding);
 	void setBinding(const std::vector<std::string>& bindings_);
 	void setColor(const sf::Color& color) { text->setColor(color); }
-	void setFormat(const std::string& format_) { format = format_; }
+	void setFormat(const std::string& format_)
+	{
+		format = format_;
+		bindings.invalidate();
+	}
 	void setHorizontalAlign(const HorizontalAlign align) { text->setHorizontalAlign(align); }
 	void setVerticalAlign(const VerticalAlign align) { text->setVerticalAlign(align); }
 	virtual void setHorizontalSpaceOffset(int offset) { text->setHorizontalSpaceOffset(offset); }
@@ -0,0 +1,98 @@
+#include "TextBindings.h"
+#include "Game.h"
+#include "GameUtils.h"
+#include "Utils.h"
+
+void TextBindings::set(const std::vector<std::string>& bindings_)
+{
+	bindings = bindings_;
+	resolved.clear();
+	values.clear();
+	valid = false;
+}
+
+bool TextBindings::update(Game& game)
+{
+	auto changed = (valid == false);
+	if (resolved.size() != bindings.size())
+	{
+		resolve(game);
+		changed = true;
+	}
+	for (size_t i = 0; i < bindings.size(); i++)
+	{
+		// same as Game::getVarOrPropString
+		auto& binding = resolved[i];
+		const Variable* value = nullptr;
+		if (binding.varId != VariableStore::InvalidId)
+		{
+			value = game.getVariableValue(binding.varId);
+			if (value != nullptr &&
+				value->is<std::string>() == true &&
+				GameUtils::getObjectProperty(game, value->get<std::string>(), propValue) == true)
+			{
+				value = &propValue;
+			}
+		}
+		else if (binding.objectId.empty() == false &&
+			GameUtils::getObjectProperty(game, binding.objectId, binding.objectProp, propValue) == true)
+		{
+			value = &propValue;
+		}
+
+		// bindings without a value are shown as they are
+		if (value == nullptr)
+		{
+			if (binding.hasValue == true)
+			{
+				binding.hasValue = false;
+				values[i] = bindings[i];
+				changed = true;
+			}
+			continue;
+		}
+		if (binding.hasValue == false || (*value == binding.value) == false)
+		{
+			binding.value = *value;
+			binding.hasValue = true;
+			values[i] = VarUtils::toString(*value);
+			changed = true;
+		}
+	}
+	valid = true;
+	if (changed == true)
+	{
+		game.getTextBindingStats().executed++;
+	}
+	else
+	{
+		game.getTextBindingStats().skipped++;
+	}
+	return changed;
+}
+
+void TextBindings::resolve(Game& game)
+{
+	resolved.clear();
+	resolved.resize(bindings.size());
+	values = bindings;
+	for (size_t i = 0; i < bindings.size(); i++)
+	{
+		const auto& key = bindings[i];
+		auto& binding = resolved[i];
+		if (key.size() > 2 &&
+			key.front() == '%' &&
+			key.back() == '%')
+		{
+			binding.varId = game.getVariableId(key.substr(1, key.size() - 2));
+		}
+		else if (key.size() > 3 &&
+			key.front() == '|' &&
+			key.back() == '|')
+		{
+			auto props = Utils::splitStringIn2(key.substr(1, key.size() - 2), '|');
+			binding.objectId = props.first;
+			binding.objectProp = props.second;
+		}
+	}
+}
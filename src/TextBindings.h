@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include "Variable.h"
+#include "VariableStore.h"
+#include <vector>
+
+class Game;
+
+// Counts the refreshes of bound texts: executed when a bound value changed
+// and the text was formatted again, skipped when all values were the same.
+struct TextBindingStats
+{
+	uint64_t executed{ 0 };
+	uint64_t skipped{ 0 };
+};
+
+// The bindings of a text ("%var%", "|id|property|") with the values they
+// had the last time the text was formatted, so the text is only formatted
+// (and laid out) again when one of them changes. Bindings are resolved
+// once to a variable id or to the object id and property, and the values
+// are compared as variables, so unchanged values aren't made into strings.
+class TextBindings
+{
+private:
+	struct Binding
+	{
+		uint32_t varId{ VariableStore::InvalidId };
+		std::string objectId;
+		std::string objectProp;
+		Variable value;
+		bool hasValue{ false };
+	};
+
+	std::vector<std::string> bindings;
+	std::vector<Binding> resolved;
+	std::vector<std::string> values;
+	Variable propValue;
+	std::string text;
+	bool valid{ false };
+
+	// finds the variable id or the object and property of each binding.
+	void resolve(Game& game);
+
+public:
+	TextBindings() {}
+	TextBindings(const std::vector<std::string>& bindings_) : bindings(bindings_) {}
+
+	const std::vector<std::string>& get() const { return bindings; }
+	void set(const std::vector<std::string>& bindings_);
+
+	bool empty() const { return bindings.empty(); }
+
+	// the values of the last update.
+	const std::vector<std::string>& Values() const { return values; }
+
+	// the text formatted with the values of the last update.
+	const std::string& Text() const { return text; }
+	void Text(const std::string& text_) { text = text_; }
+
+	// forces the next update to return true.
+	void invalidate() { valid = false; }
+
+	// resolves the bindings. Returns true if a value changed since the
+	// last update (the text must be formatted again).
+	bool update(Game& game);
+};
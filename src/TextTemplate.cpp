@@ -0,0 +1,80 @@
+#include "TextTemplate.h"
+#include <cstring>
+
+static bool isNameChar(char c, bool allowDots)
+{
+	return ((c >= 'a' && c <= 'z') ||
+		(c >= 'A' && c <= 'Z') ||
+		(c >= '0' && c <= '9') ||
+		c == '_' ||
+		(c == '.' && allowDots == true));
+}
+
+TextTemplate::TextTemplate(const std::string& str_, bool allowDots) : str(str_)
+{
+	size_t literalStart = 0;
+	size_t pos = 0;
+	while ((pos = str.find('%', pos)) != std::string::npos)
+	{
+		auto end = pos + 1;
+		while (end < str.size() && isNameChar(str[end], allowDots) == true)
+		{
+			end++;
+		}
+		if (end == pos + 1 ||
+			end >= str.size() ||
+			str[end] != '%')
+		{
+			// not a placeholder, the next % can start one
+			pos++;
+			continue;
+		}
+		if (pos > literalStart)
+		{
+			segments.push_back({ literalStart, pos - literalStart, {} });
+		}
+		segments.push_back({ pos, end + 1 - pos, str.substr(pos + 1, end - pos - 1) });
+		numPlaceholders++;
+		pos = end + 1;
+		literalStart = pos;
+	}
+	if (literalStart < str.size())
+	{
+		segments.push_back({ literalStart, str.size() - literalStart, {} });
+	}
+}
+
+bool TextTemplate::mayHavePlaceholders(const char* str)
+{
+	auto first = std::strchr(str, '%');
+	return first != nullptr && std::strchr(first + 1, '%') != nullptr;
+}
+
+const std::string& TextTemplate::getPlaceholder(size_t idx) const
+{
+	static const std::string emptyName;
+	for (const auto& segment : segments)
+	{
+		if (segment.name.empty() == false)
+		{
+			if (idx == 0)
+			{
+				return segment.name;
+			}
+			idx--;
+		}
+	}
+	return emptyName;
+}
+
+void TextTemplate::appendVariable(std::string& buffer, const Variable& var)
+{
+	if (var.is<std::string>() == true)
+	{
+		buffer.append(var.get<std::string>());
+	}
+	else
+	{
+		buffer.append(VarUtils::toString(var));
+	}
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include "Variable.h"
+#include <vector>
+
+// A string with %name% placeholders, scanned once into literal and
+// placeholder segments. Rendering appends the segments to a buffer and asks
+// a function for the value of each placeholder. Placeholders without a
+// value are kept as they are.
+class TextTemplate
+{
+private:
+	struct Segment
+	{
+		// position and size in str (with the % for placeholders)
+		size_t start;
+		size_t size;
+		// placeholder name (without the %) or empty for literals
+		std::string name;
+	};
+
+	std::string str;
+	std::vector<Segment> segments;
+	size_t numPlaceholders{ 0 };
+
+	static void appendVariable(std::string& buffer, const Variable& var);
+
+public:
+	TextTemplate() {}
+
+	// allowDots allows '.' in the placeholder names (%currentLevel.name%).
+	TextTemplate(const std::string& str_, bool allowDots = true);
+
+	// returns true if str has a placeholder, without scanning it all.
+	static bool mayHavePlaceholders(const char* str);
+
+	const std::string& getString() const { return str; }
+
+	bool hasPlaceholders() const { return numPlaceholders > 0; }
+
+	// true if the whole string is one placeholder ("%name%").
+	bool isPlaceholder() const { return numPlaceholders == 1 && segments.size() == 1; }
+
+	const std::string& getPlaceholder(size_t idx) const;
+
+	// appends the rendered string to buffer. getValue is called as
+	// bool getValue(const std::string& name, Variable& var).
+	// returns the number of placeholders that were replaced.
+	template <class GetValue>
+	size_t render(std::string& buffer, GetValue getValue) const
+	{
+		size_t numReplaced = 0;
+		Variable var;
+		for (const auto& segment : segments)
+		{
+			if (segment.name.empty() == false &&
+				getValue(segment.name, var) == true)
+			{
+				appendVariable(buffer, var);
+				numReplaced++;
+			}
+			else
+			{
+				buffer.append(str, segment.start, segment.size);
+			}
+		}
+		return numReplaced;
+	}
+};
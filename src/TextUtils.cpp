@@ -4,27 +4,38 @@
 
 namespace TextUtils
 {
-	std::string getFormatString(const Game& game, const std::string& format,
-		const std::vector<std::string>& bindings)
+	static void transformText(TextOp textOp, std::string& str)
+	{
+		if ((uint32_t)textOp & (uint32_t)TextOp::Trim)
+		{
+			str = Utils::trim(str, " \t\r\n");
+		}
+		if ((uint32_t)textOp & (uint32_t)TextOp::RemoveEmptyLines)
+		{
+			str = Utils::removeEmptyLines(str);
+		}
+	}
+
+	std::string formatString(const std::string& format,
+		const std::vector<std::string>& values)
 	{
-		if (bindings.size() > 0)
+		if (values.size() > 0)
 		{
 			if (format == "[1]")
 			{
-				return game.getVarOrPropString(bindings[0]);
+				return values[0];
 			}
 			else
 			{
 				std::string displayText = format;
 				if (format.size() > 2)
 				{
-					for (size_t i = 0; i < bindings.size(); i++)
+					for (size_t i = 0; i < values.size(); i++)
 					{
-						auto str = game.getVarOrPropString(bindings[i]);
 						Utils::replaceStringInPlace(
 							displayText,
 							"[" + std::to_string(i + 1) + "]",
-							str);
+							values[i]);
 					}
 				}
 				return displayText;
@@ -33,7 +44,22 @@ namespace TextUtils
 		return "";
 	}
 
-	std::string getTextQueryable(const Game& game, const std::string& format,
+	std::string getFormatString(const Game& game, const std::string& format,
+		const std::vector<std::string>& bindings)
+	{
+		if (format == "[1]" && bindings.size() > 0)
+		{
+			return game.getVarOrPropString(bindings[0]);
+		}
+		std::vector<std::string> values;
+		for (const auto& binding : bindings)
+		{
+			values.push_back(game.getVarOrPropString(binding));
+		}
+		return formatString(format, values);
+	}
+
+	std::string getTextQueryable(const Game& game, const TextTemplate& format,
 		const std::string& query)
 	{
 		auto queryable = game.getQueryable(query);
@@ -41,10 +67,10 @@ namespace TextUtils
 		{
 			return GameUtils::replaceStringWithQueryable(format, *queryable);
 		}
-		return format;
+		return format.getString();
 	}
 
-	std::string getText(const Game& game, TextOp textOp, const std::string& textOrformat,
+	std::string getText(const Game& game, TextOp textOp, const TextTemplate& textOrformat,
 		const std::vector<std::string>& bindings)
 	{
 		std::string str;
@@ -52,13 +78,13 @@ namespace TextUtils
 		{
 		default:
 		case TextOp::Set:
-			str = textOrformat;
+			str = textOrformat.getString();
 			break;
 		case TextOp::Replace:
-			str = game.getVarOrPropString(textOrformat);
+			str = game.getVarOrPropString(textOrformat.getString());
 			break;
 		case TextOp::ReplaceAll:
-			str = game.getVarOrPropString(textOrformat);
+			str = game.getVarOrPropString(textOrformat.getString());
 			break;
 		case TextOp::Query:
 		{
@@ -68,22 +94,31 @@ namespace TextUtils
 			}
 			else
 			{
-				str = textOrformat;
+				str = textOrformat.getString();
 			}
 		}
 		break;
 		case TextOp::FormatString:
-			str = getFormatString(game, textOrformat, bindings);
+			str = getFormatString(game, textOrformat.getString(), bindings);
 			break;
 		}
-		if ((uint32_t)textOp & (uint32_t)TextOp::Trim)
+		transformText(textOp, str);
+		return str;
+	}
+
+	std::string getText(Game& game, TextOp textOp, const TextTemplate& textOrformat,
+		TextBindings& bindings)
+	{
+		if (TextOp(((uint32_t)textOp) & 0x7u) != TextOp::FormatString)
 		{
-			str = Utils::trim(str, " \t\r\n");
+			return getText(game, textOp, textOrformat, bindings.get());
 		}
-		if ((uint32_t)textOp & (uint32_t)TextOp::RemoveEmptyLines)
+		if (bindings.update(game) == true)
 		{
-			str = Utils::removeEmptyLines(str);
+			auto str = formatString(textOrformat.getString(), bindings.Values());
+			transformText(textOp, str);
+			bindings.Text(str);
 		}
-		return str;
+		return bindings.Text();
 	}
 }
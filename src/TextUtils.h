@@ -1,6 +1,8 @@
 #pragma once
 
 #include <string>
+#include "TextBindings.h"
+#include "TextTemplate.h"
 #include <vector>
 
 class Game;
@@ -28,12 +30,21 @@ namespace TextUtils
 	inline TextOp& operator&= (TextOp& a, TextOp b) { a = (TextOp)(static_cast<T>(a) & static_cast<T>(b)); return a; }
 	inline TextOp& operator^= (TextOp& a, TextOp b) { a = (TextOp)(static_cast<T>(a) ^ static_cast<T>(b)); return a; }
 
+	// replaces [1], [2], ... in format with the values.
+	std::string formatString(const std::string& format,
+		const std::vector<std::string>& values);
+
 	std::string getFormatString(const Game& game, const std::string& format,
 		const std::vector<std::string>& bindings);
 
-	std::string getTextQueryable(const Game& game, const std::string& format,
+	std::string getTextQueryable(const Game& game, const TextTemplate& format,
 		const std::string& query);
 
-	std::string getText(const Game& game, TextOp textOp, const std::string& textOrformat,
+	// textOrformat is scanned for %placeholders% once, when the text is parsed.
+	std::string getText(const Game& game, TextOp textOp, const TextTemplate& textOrformat,
 		const std::vector<std::string>& bindings);
+
+	// for FormatString, only formats the text again if a bound value changed.
+	std::string getText(Game& game, TextOp textOp, const TextTemplate& textOrformat,
+		TextBindings& bindings);
 }
@@ -29,7 +29,14 @@ public:
 	// Update
 	virtual void update(Game& game) = 0;
 
+	// Interpolate (only called with a fixed timestep, alpha is how far
+	// the frame is between the last update and the next one)
+	virtual void interpolate(float alpha) {}
+
 	// Visible
 	virtual bool Visible() const = 0;
 	virtual void Visible(bool visible) = 0;
+
+	// Occlusion (true if the object hides everything under rect when drawn)
+	virtual bool getOpaqueRect(sf::FloatRect& rect) const { return false; }
 };
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <cmath>
+#include <cstdint>
 #include <random>
 #include <string>
 #include <vector>
@@ -73,6 +74,9 @@ namespace Utils
 		static std::mt19937 mt;
 
 	public:
+		// makes the numbers repeat (replaying input recordings)
+		static void seed(uint32_t value) { mt.seed(value); }
+
 		template <class T>
 		static T get(T max)
 		{
@@ -0,0 +1,76 @@
+#include "VariableStore.h"
+
+uint32_t VariableStore::getId(const std::string& name)
+{
+	auto it = ids.find(name);
+	if (it != ids.end())
+	{
+		return it->second;
+	}
+	auto id = (uint32_t)names.size();
+	ids.insert(std::make_pair(name, id));
+	percentageIds.insert(std::make_pair('%' + name + '%', id));
+	names.push_back(name);
+	values.push_back({});
+	hasValue.push_back(false);
+	return id;
+}
+
+uint32_t VariableStore::findId(const std::string& name) const
+{
+	auto it = ids.find(name);
+	if (it != ids.end())
+	{
+		return it->second;
+	}
+	return InvalidId;
+}
+
+uint32_t VariableStore::findIdPercentage(const std::string& key) const
+{
+	auto it = percentageIds.find(key);
+	if (it != percentageIds.end())
+	{
+		return it->second;
+	}
+	return InvalidId;
+}
+
+bool VariableStore::get(uint32_t id, Variable& var) const
+{
+	if (id < values.size() &&
+		hasValue[id] == true)
+	{
+		var = values[id];
+		return true;
+	}
+	return false;
+}
+
+const Variable* VariableStore::getValue(uint32_t id) const
+{
+	if (id < values.size() &&
+		hasValue[id] == true)
+	{
+		return &values[id];
+	}
+	return nullptr;
+}
+
+void VariableStore::set(uint32_t id, const Variable& value)
+{
+	if (id < values.size())
+	{
+		values[id] = value;
+		hasValue[id] = true;
+	}
+}
+
+void VariableStore::clear(uint32_t id)
+{
+	if (id < values.size())
+	{
+		values[id] = {};
+		hasValue[id] = false;
+	}
+}
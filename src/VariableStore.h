@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include "Variable.h"
+#include <vector>
+
+// Game variables. Each name gets a dense id the first time it's used
+// and the values are kept in a vector indexed by id, so actions can resolve
+// their variables once (when parsed) and then get and set them by id.
+// Clearing a variable keeps its id.
+class VariableStore
+{
+public:
+	static const uint32_t InvalidId = 0xFFFFFFFF;
+
+private:
+	std::unordered_map<std::string, uint32_t> ids;
+	// the ids by "%name%", so those keys are found without a substring
+	std::unordered_map<std::string, uint32_t> percentageIds;
+	std::vector<std::string> names;
+	std::vector<Variable> values;
+	std::vector<bool> hasValue;
+
+public:
+	// returns the id of a variable name, adding it if it doesn't exist.
+	uint32_t getId(const std::string& name);
+
+	// returns the id of a variable name or InvalidId.
+	uint32_t findId(const std::string& name) const;
+
+	// returns the id of a variable in the "%name%" form or InvalidId.
+	uint32_t findIdPercentage(const std::string& key) const;
+
+	const std::string& getName(uint32_t id) const { return names[id]; }
+
+	bool get(uint32_t id, Variable& var) const;
+
+	// returns the value of a variable (not a copy) or nullptr if it isn't set.
+	const Variable* getValue(uint32_t id) const;
+	void set(uint32_t id, const Variable& value);
+	void clear(uint32_t id);
+};